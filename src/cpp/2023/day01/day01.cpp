@@ -1,95 +1,102 @@
+#include <bytescan.h>
 #include <file.h>
+#include <stringextras.h>
 
 #include <algorithm>
 #include <chrono>
 #include <iostream>
-#include <regex>
 #include <string>
+#include <string_view>
 #include <vector>
 
-int partOne(const std::vector<std::string>& lines) {
-  int total = 0;
-  for (const std::string& line : lines) {
-    int firstDigit = -1;
-    int lastDigit = -1;
-    for (char ch : line) {
-      if (ch >= '0' && ch <= '9') {
-        if (firstDigit == -1) {
-          firstDigit = ch - '0';
-        }
-        lastDigit = ch - '0';
-      }
-    }
-
-    int number = firstDigit * 10 + lastDigit;
-    total += number;
+int calibrationValue(std::string_view line) {
+  size_t first = scanForDigit(line);
+  if (first == std::string_view::npos) {
+    throw std::runtime_error("no digit found");
   }
+  size_t last = scanForLastDigit(line);
 
-  return total;
+  int firstDigit = line[first] - '0';
+  int lastDigit = line[last] - '0';
+  return firstDigit * 10 + lastDigit;
 }
 
-int partTwo(const std::vector<std::string>& lines) {
-  std::map<std::string, int> wordToDigit = {
-      {"one", 1}, {"two", 2},   {"three", 3}, {"four", 4}, {"five", 5},
-      {"six", 6}, {"seven", 7}, {"eight", 8}, {"nine", 9}};
-
-  int total = 0;
-
-  for (const std::string& line : lines) {
-    // Turn all digits into words
-    std::string str = line;
-    for (const auto& pair : wordToDigit) {
-      std::regex search(std::to_string(pair.second));
-      std::string replace = pair.first;
-      str = std::regex_replace(str, search, replace);
+// "1" to "9" then "one" to "nine", so pattern i is the digit (i % 9) + 1
+const MultiPatternMatcher digitMatcher({"1", "2", "3", "4", "5", "6", "7", "8",
+                                        "9", "one", "two", "three", "four",
+                                        "five", "six", "seven", "eight",
+                                        "nine"});
+
+int calibrationValueWithWords(std::string_view line) {
+  // overlapping matches are reported, so "oneight" ends in an 8
+  size_t firstPos = std::string_view::npos;
+  size_t lastPos = 0;
+  int firstDigit = -1;
+  int lastDigit = -1;
+  digitMatcher.forEachMatch(line, [&](MultiPatternMatcher::Match match) {
+    int digit = match.pattern % 9 + 1;
+    if (firstDigit == -1 || match.position < firstPos) {
+      firstPos = match.position;
+      firstDigit = digit;
     }
-
-    // Find the earliest digit word
-    size_t earliestPos = std::string::npos;
-    std::string earliestWord = "";
-    for (const auto& pair : wordToDigit) {
-      size_t pos = str.find(pair.first);
-      if (pos != std::string::npos && pos < earliestPos) {
-        earliestPos = pos;
-        earliestWord = pair.first;
-      }
+    if (lastDigit == -1 || match.position >= lastPos) {
+      lastPos = match.position;
+      lastDigit = digit;
     }
-    if (earliestWord == "") {
-      throw std::runtime_error("no digit found");
-    }
-    int firstDigit = wordToDigit.at(earliestWord);
+  });
 
-    // Find the latest digit word
-    size_t latestPos = 0;
-    std::string latestWord = "";
-    for (const auto& pair : wordToDigit) {
-      size_t pos = str.rfind(pair.first);
-      if (pos != std::string::npos && pos >= latestPos) {
-        latestPos = pos;
-        latestWord = pair.first;
-      }
-    }
-    if (latestWord == "") {
-      throw std::runtime_error("no digit found");
-    }
-    int lastDigit = wordToDigit.at(latestWord);
+  if (firstDigit == -1) {
+    throw std::runtime_error("no digit found");
+  }
+  return firstDigit * 10 + lastDigit;
+}
 
-    int number = firstDigit * 10 + lastDigit;
-    total += number;
+int partOne(const std::vector<std::string_view>& lines) {
+  int total = 0;
+  for (std::string_view line : lines) {
+    total += calibrationValue(line);
   }
+  return total;
+}
 
+int partTwo(const std::vector<std::string_view>& lines) {
+  int total = 0;
+  for (std::string_view line : lines) {
+    total += calibrationValueWithWords(line);
+  }
   return total;
 }
 
-int main() {
-  std::vector<std::string> lines = fileLines<std::string>("input.txt");
+// Both parts in a single pass over a file of any size
+std::pair<long, long> solveStreaming(const std::string& filename) {
+  long totalOne = 0;
+  long totalTwo = 0;
+  streamLines(filename, [&](std::string_view line) {
+    totalOne += calibrationValue(line);
+    totalTwo += calibrationValueWithWords(line);
+  });
+  return {totalOne, totalTwo};
+}
 
+int main(int argc, char* argv[]) {
   auto start = std::chrono::high_resolution_clock::now();
 
-  std::cout << "Part 1:\n";
-  std::cout << partOne(lines) << std::endl;
-  std::cout << "Part 2:\n";
-  std::cout << partTwo(lines) << std::endl;
+  if (argc > 1) {
+    // stream the given file instead of loading input.txt into memory
+    auto [one, two] = solveStreaming(argv[1]);
+    std::cout << "Part 1:\n";
+    std::cout << one << std::endl;
+    std::cout << "Part 2:\n";
+    std::cout << two << std::endl;
+  } else {
+    MappedInput input("input.txt");
+    const std::vector<std::string_view>& lines = input.lines();
+
+    std::cout << "Part 1:\n";
+    std::cout << partOne(lines) << std::endl;
+    std::cout << "Part 2:\n";
+    std::cout << partTwo(lines) << std::endl;
+  }
 
   auto end = std::chrono::high_resolution_clock::now();
   auto duration =
@@ -1,11 +1,12 @@
 #include <file.h>
+#include <scan.h>
 #include <stringextras.h>
 
 #include <algorithm>
 #include <chrono>
 #include <iostream>
-#include <regex>
 #include <string>
+#include <string_view>
 #include <vector>
 
 struct Subset {
@@ -19,17 +20,65 @@ struct Game {
   std::vector<Subset> subsets;
 };
 
+constexpr char GAME_FORMAT[] = "Game {d}: {}";
+constexpr char DRAW_FORMAT[] = "{d} {}";
+
+Game parseGame(std::string_view line) {
+  auto gameMatch = scan<GAME_FORMAT>(line);
+  if (!gameMatch) {
+    throw std::runtime_error("No match for line: " + std::string(line));
+  }
+  auto [id, rest] = *gameMatch;
+
+  Game game;
+  game.id = id;
+
+  for (std::string_view subsetStr : strTokens(rest, ';')) {
+    Subset subset{0, 0, 0};
+    for (std::string_view cubeDraw : strTokens(subsetStr, ',')) {
+      auto drawMatch = scan<DRAW_FORMAT>(cubeDraw);
+      if (!drawMatch) {
+        throw std::runtime_error("Can't parse cube draw: " +
+                                 std::string(cubeDraw));
+      }
+      auto [count, color] = *drawMatch;
+      if (color == "red") {
+        subset.red = count;
+      } else if (color == "green") {
+        subset.green = count;
+      } else {
+        subset.blue = count;
+      }
+    }
+    game.subsets.push_back(subset);
+  }
+
+  return game;
+}
+
+bool isPossible(const Game& game) {
+  for (const auto& subset : game.subsets) {
+    if (subset.red > 12 || subset.green > 13 || subset.blue > 14) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int power(const Game& game) {
+  Subset max{0, 0, 0};
+  for (const auto& subset : game.subsets) {
+    if (subset.red > max.red) max.red = subset.red;
+    if (subset.green > max.green) max.green = subset.green;
+    if (subset.blue > max.blue) max.blue = subset.blue;
+  }
+  return max.red * max.green * max.blue;
+}
+
 int partOne(std::vector<Game>& games) {
   int totalPossible = 0;
   for (const auto& game : games) {
-    bool valid = true;
-    for (const auto& subset : game.subsets) {
-      if (subset.red > 12 || subset.green > 13 || subset.blue > 14) {
-        valid = false;
-        break;
-      }
-    }
-    if (valid) {
+    if (isPossible(game)) {
       totalPossible += game.id;
     }
   }
@@ -39,70 +88,47 @@ int partOne(std::vector<Game>& games) {
 int partTwo(std::vector<Game>& games) {
   int totalPower = 0;
   for (const auto& game : games) {
-    Subset max{0, 0, 0};
-    for (const auto& subset : game.subsets) {
-      if (subset.red > max.red) max.red = subset.red;
-      if (subset.green > max.green) max.green = subset.green;
-      if (subset.blue > max.blue) max.blue = subset.blue;
-    }
-    int power = max.red * max.green * max.blue;
-    totalPower += power;
+    totalPower += power(game);
   }
   return totalPower;
 }
 
-int main() {
-  std::vector<std::string> lines = fileLines<std::string>("input.txt");
-
-  std::regex gamePattern(R"(Game (\d+): (.*))");
-  std::regex drawPattern(R"((\d+) (red|green|blue))");
-  std::vector<Game> games{};
-  std::transform(
-      lines.begin(), lines.end(), std::back_inserter(games),
-      [gamePattern, drawPattern](std::string& line) {
-        std::smatch gameMatch;
-        if (std::regex_search(line, gameMatch, gamePattern)) {
-          int id = std::stoi(gameMatch[1].str());
-          std::string rest = gameMatch[2].str();
-
-          Game game;
-          game.id = id;
-
-          std::vector<std::string> subsetStrs = strSplit(rest, ";");
-
-          for (const auto& subsetStr : subsetStrs) {
-            std::vector<std::string> cubeDraws = strSplit(subsetStr, ",");
-            Subset subset{0, 0, 0};
-            for (const auto& cubeDraw : cubeDraws) {
-              std::smatch drawMatch;
-              if (std::regex_search(cubeDraw, drawMatch, drawPattern)) {
-                int count = std::stoi(drawMatch[1].str());
-                if (drawMatch[2].str() == "red") {
-                  subset.red = count;
-                } else if (drawMatch[2].str() == "green") {
-                  subset.green = count;
-                } else {
-                  subset.blue = count;
-                }
-              } else {
-                throw std::runtime_error("Can't parse cube draw: " + cubeDraw);
-              }
-            }
-            game.subsets.push_back(subset);
-          }
-
-          return game;
-        } else {
-          throw std::runtime_error("No match for line: " + line);
-        }
-      });
+// Both parts in a single pass over a file of any size
+std::pair<long, long> solveStreaming(const std::string& filename) {
+  long totalPossible = 0;
+  long totalPower = 0;
+  streamLines(filename, [&](std::string_view line) {
+    Game game = parseGame(line);
+    if (isPossible(game)) {
+      totalPossible += game.id;
+    }
+    totalPower += power(game);
+  });
+  return {totalPossible, totalPower};
+}
 
+int main(int argc, char* argv[]) {
   auto start = std::chrono::high_resolution_clock::now();
 
-  std::cout << "Part 1:\n";
-  std::cout << partOne(games) << std::endl;
-  std::cout << "Part 2:\n";
-  std::cout << partTwo(games) << std::endl;
+  if (argc > 1) {
+    // stream the given file instead of loading input.txt into memory
+    auto [one, two] = solveStreaming(argv[1]);
+    std::cout << "Part 1:\n";
+    std::cout << one << std::endl;
+    std::cout << "Part 2:\n";
+    std::cout << two << std::endl;
+  } else {
+    std::vector<std::string> lines = fileLines<std::string>("input.txt");
+
+    std::vector<Game> games{};
+    std::transform(lines.begin(), lines.end(), std::back_inserter(games),
+                   parseGame);
+
+    std::cout << "Part 1:\n";
+    std::cout << partOne(games) << std::endl;
+    std::cout << "Part 2:\n";
+    std::cout << partTwo(games) << std::endl;
+  }
 
   auto end = std::chrono::high_resolution_clock::now();
   auto duration =
@@ -1,3 +1,4 @@
+#include <chargridview.h>
 #include <file.h>
 #include <grid.h>
 
@@ -5,13 +6,14 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 bool isDigit(char ch) { return ch >= '0' && ch <= '9'; }
 
 bool isSymbol(char ch) { return !isDigit(ch) && ch != '.'; }
 
-int partOne(Grid2D<char> grid) {
+int partOne(const CharGridView& grid) {
   int total = 0;
   Point2D bottomRight = grid.rbegin()->first;
   for (int y = 0; y <= bottomRight.y; y++) {
@@ -30,7 +32,7 @@ int partOne(Grid2D<char> grid) {
         // Check if there is a symbol near this point if this number doesn't
         // have one yet
         if (!hasSymbol) {
-          for (const auto& pair : grid.pointsAdjacent(point)) {
+          for (const auto& pair : grid.neighbors(point)) {
             if (isSymbol(pair.second)) {
               // Symbol found!
               hasSymbol = true;
@@ -60,7 +62,7 @@ int partOne(Grid2D<char> grid) {
   return total;
 }
 
-int partTwo(Grid2D<char> grid) {
+int partTwo(const CharGridView& grid) {
   // key: gear location; value: list of part numbers around that gear
   std::map<Point2D, std::vector<int>> gears{};
 
@@ -82,7 +84,7 @@ int partTwo(Grid2D<char> grid) {
         // Check if there is a gear near this point if this number doesn't
         // have one yet
         if (!hasGear) {
-          for (const auto& pair : grid.pointsAdjacent(point)) {
+          for (const auto& pair : grid.neighbors(point)) {
             if (pair.second == '*') {
               // Gear found!
               hasGear = true;
@@ -123,9 +125,8 @@ int partTwo(Grid2D<char> grid) {
 }
 
 int main() {
-  std::vector<std::string> lines = fileLines<std::string>("input.txt");
-
-  Grid2D<char> grid = linesToGrid(lines);
+  MappedInput input("input.txt");
+  CharGridView grid(input);
 
   auto start = std::chrono::high_resolution_clock::now();
 
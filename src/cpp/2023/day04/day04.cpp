@@ -7,6 +7,7 @@
 #include <regex>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 struct Card {
@@ -15,18 +16,51 @@ struct Card {
   std::set<int> have;
 };
 
+Card parseCard(std::string_view line) {
+  auto split = strTokens(line, ": ").begin();
+  std::string_view label = *split++;
+  std::string_view numbers = *split;
+
+  // "Card   12": the number is the last token
+  int cardNumber = 0;
+  for (std::string_view token : strTokens(label, ' ')) {
+    cardNumber = strToTemplate<int>(token);
+  }
+
+  auto numberSets = strTokens(numbers, " | ").begin();
+  std::string_view winningNumbers = *numberSets++;
+  std::string_view heldNumbers = *numberSets;
+
+  std::set<int> winners{};
+  for (std::string_view num : strTokens(winningNumbers, ' ')) {
+    winners.insert(strToTemplate<int>(num));
+  }
+
+  std::set<int> have{};
+  for (std::string_view num : strTokens(heldNumbers, ' ')) {
+    have.insert(strToTemplate<int>(num));
+  }
+
+  return Card{cardNumber, winners, have};
+}
+
+int winnerCount(const Card& card) {
+  int winnerCount = 0;
+  for (const auto& held : card.have) {
+    if (card.winners.count(held) > 0) {
+      winnerCount++;
+    }
+  }
+  return winnerCount;
+}
+
 int partOne(std::vector<Card>& cards) {
   int total = 0;
 
   for (const auto& card : cards) {
-    int winnerCount = 0;
-    for (const auto& held : card.have) {
-      if (card.winners.count(held) > 0) {
-        winnerCount++;
-      }
-    }
-    if (winnerCount > 0) {
-      total += std::pow(2, winnerCount - 1);
+    int winners = winnerCount(card);
+    if (winners > 0) {
+      total += std::pow(2, winners - 1);
     }
   }
 
@@ -40,17 +74,10 @@ int partTwo(std::vector<Card>& cards) {
     // always count the card we got for free
     cardCounts[card.number]++;
 
-    // how many winners?
-    int winnerCount = 0;
-    for (const auto& held : card.have) {
-      if (card.winners.count(held) > 0) {
-        winnerCount++;
-      }
-    }
-
     // for each winning number, find the next card and give it as many copies as
     // we had of this card
-    for (int i = 1; i <= winnerCount; i++) {
+    int winners = winnerCount(card);
+    for (int i = 1; i <= winners; i++) {
       cardCounts[card.number + i] += cardCounts[card.number];
     }
   }
@@ -64,41 +91,55 @@ int partTwo(std::vector<Card>& cards) {
   return total;
 }
 
-int main() {
-  std::vector<std::string> lines = fileLines<std::string>("input.txt");
-
-  std::vector<Card> cards{};
-  for (const auto& line : lines) {
-    std::vector<std::string> split = strSplit(line, ": ");
-
-    int cardNumber = std::stoi(strSplit(split[0], " ").back());
-    std::vector<std::string> numberSets = strSplit(split[1], " | ");
-    std::vector<std::string> winningNumberStrs = strSplit(numberSets[0], " ");
-    std::vector<std::string> heldNumberStrs = strSplit(numberSets[1], " ");
-
-    std::set<int> winners{};
-    for (const auto& numOrBlank : winningNumberStrs) {
-      if (numOrBlank != "") {
-        winners.insert(std::stoi(numOrBlank));
-      }
+// Both parts in a single pass over a file of any size. Part two only needs the
+// copy counts of the cards still ahead of us, so each card's count is dropped
+// as soon as it has been added to the total.
+std::pair<long, long> solveStreaming(const std::string& filename) {
+  long totalOne = 0;
+  long totalTwo = 0;
+  std::map<int, long> cardCounts;
+  streamLines(filename, [&](std::string_view line) {
+    Card card = parseCard(line);
+
+    int winners = winnerCount(card);
+    if (winners > 0) {
+      totalOne += 1L << (winners - 1);
     }
 
-    std::set<int> have{};
-    for (const auto& numOrBlank : heldNumberStrs) {
-      if (numOrBlank != "") {
-        have.insert(std::stoi(numOrBlank));
-      }
+    long copies = ++cardCounts[card.number];
+    for (int i = 1; i <= winners; i++) {
+      cardCounts[card.number + i] += copies;
     }
+    totalTwo += copies;
+    cardCounts.erase(card.number);
+  });
+  return {totalOne, totalTwo};
+}
 
-    cards.push_back(Card{cardNumber, winners, have});
-  }
-
+int main(int argc, char* argv[]) {
   auto start = std::chrono::high_resolution_clock::now();
 
-  std::cout << "Part 1:\n";
-  std::cout << partOne(cards) << std::endl;
-  std::cout << "Part 2:\n";
-  std::cout << partTwo(cards) << std::endl;
+  if (argc > 1) {
+    // stream the given file instead of loading input.txt into memory
+    auto [one, two] = solveStreaming(argv[1]);
+    std::cout << "Part 1:\n";
+    std::cout << one << std::endl;
+    std::cout << "Part 2:\n";
+    std::cout << two << std::endl;
+  } else {
+    MappedInput input("input.txt");
+    const std::vector<std::string_view>& lines = input.lines();
+
+    std::vector<Card> cards{};
+    for (std::string_view line : lines) {
+      cards.push_back(parseCard(line));
+    }
+
+    std::cout << "Part 1:\n";
+    std::cout << partOne(cards) << std::endl;
+    std::cout << "Part 2:\n";
+    std::cout << partTwo(cards) << std::endl;
+  }
 
   auto end = std::chrono::high_resolution_clock::now();
   auto duration =
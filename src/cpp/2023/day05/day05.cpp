@@ -1,13 +1,17 @@
 #include <file.h>
 #include <range.h>
+#include <snapshot.h>
 #include <stringextras.h>
 
 #include <chrono>
 #include <climits>
+#include <cstdint>
 #include <future>
 #include <iostream>
 #include <set>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 struct Mapping {
@@ -116,17 +120,36 @@ long partTwo(const Input2& input) {
   return lowestLocation;
 }
 
-int main() {
-  std::vector<std::string> lines = fileLines<std::string>("input-test.txt");
+// bump when Input, Input2 or parseInputs change so old snapshots get ignored
+const uint32_t SNAPSHOT_VERSION = 1;
 
-  auto start = std::chrono::high_resolution_clock::now();
+void writeSnapshot(SnapshotWriter& out, const Input& input) {
+  out.write(input.seeds);
+  out.write(input.tiers);
+}
+
+void readSnapshot(SnapshotReader& in, Input& input) {
+  in.read(input.seeds);
+  in.read(input.tiers);
+}
+
+void writeSnapshot(SnapshotWriter& out, const Input2& input) {
+  out.write(input.seedRanges);
+  out.write(input.tiers);
+}
 
+void readSnapshot(SnapshotReader& in, Input2& input) {
+  in.read(input.seedRanges);
+  in.read(input.tiers);
+}
+
+std::pair<Input, Input2> parseInputs(const MappedInput& file) {
   Input input{std::set<long>{}, std::vector<std::vector<Mapping>>{}};
   Input2 input2{std::vector<Range<long>>{},
                 std::vector<std::vector<Mapping>>{}};
 
   int section = -1;  // -1=seeds, 0-6=tier indices
-  for (const auto& line : lines) {
+  for (std::string_view line : file.lines()) {
     if (line == "") {
       section++;
       input.tiers.push_back(std::vector<Mapping>{});
@@ -135,32 +158,41 @@ int main() {
 
     if (section == -1) {
       // reading seeds
-      std::string rest = line.substr(7);
-      std::vector<std::string> numsVec = strSplit(rest, " ");
-      for (const auto& numStr : numsVec) {
-        input.seeds.insert(std::stol(numStr));
+      std::string_view rest = line.substr(7);
+      std::vector<long> nums{};
+      for (std::string_view numStr : strTokens(rest, ' ')) {
+        nums.push_back(strToTemplate<long>(numStr));
       }
-      for (int i = 0; i < numsVec.size(); i += 2) {
-        long start = std::stol(numsVec[i]);
-        long len = std::stol(numsVec[i + 1]);
+      input.seeds.insert(nums.begin(), nums.end());
+      for (size_t i = 0; i < nums.size(); i += 2) {
+        long start = nums[i];
+        long len = nums[i + 1];
         Range<long> range{start, start + len - 1};
         input2.seedRanges.push_back(range);
       }
     } else {
-      if (line.find(":") != std::string::npos) {
+      if (line.find(":") != std::string_view::npos) {
         // section header; skip this line
         continue;
       }
       // reading tiers
-      std::vector<std::string> numsVec = strSplit(line, " ");
-      long destStart = std::stol(numsVec[0]);
-      long srcStart = std::stol(numsVec[1]);
-      long len = std::stol(numsVec[2]);
+      auto [destStart, srcStart, len] =
+          parseRecord<long, long, long>(line, ' ');
       input.tiers[section].push_back(Mapping{srcStart, destStart, len});
     }
   }
   input2.tiers = input.tiers;
 
+  return {input, input2};
+}
+
+int main() {
+  auto start = std::chrono::high_resolution_clock::now();
+
+  // warm runs load the parsed input from input-test.txt.snap
+  auto [input, input2] = cachedParse<std::pair<Input, Input2>>(
+      "input-test.txt", SNAPSHOT_VERSION, parseInputs);
+
   std::cout << "Part 1:\n";
   std::cout << partOne(input) << std::endl;
   std::cout << "Part 2:\n";
@@ -4,7 +4,9 @@
 #include <chrono>
 #include <iostream>
 #include <map>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 long simulateRace(long timeToHold, long maxTime) {
@@ -37,30 +39,62 @@ long partTwo(long time, long distanceRecord) {
   return beatenCount;
 }
 
-int main() {
-  std::vector<std::string> lines = fileLines<std::string>("input.txt");
+struct Races {
+  std::map<long, long> timeToDistance;
+  long p2Time;
+  long p2Distance;
+};
 
-  auto start = std::chrono::high_resolution_clock::now();
-
-  std::map<long, long> timeToDistance{};
-  std::vector<std::string> timeStrs = strSplit(lines[0], " ");
+Races parseRaces(const std::string &timeLine, const std::string &distanceLine) {
+  Races races{};
+  std::vector<std::string> timeStrs = strSplit(timeLine, " ");
   timeStrs.erase(timeStrs.begin());
-  std::vector<std::string> distanceStrs = strSplit(lines[1], " ");
+  std::vector<std::string> distanceStrs = strSplit(distanceLine, " ");
   distanceStrs.erase(distanceStrs.begin());
 
   for (int i = 0; i < timeStrs.size(); i++) {
     long time = std::stol(timeStrs[i]);
     long distance = std::stol(distanceStrs[i]);
-    timeToDistance[time] = distance;
+    races.timeToDistance[time] = distance;
   }
 
-  long p2Time = std::stol(strJoin(timeStrs));
-  long p2Distance = std::stol(strJoin(distanceStrs));
+  races.p2Time = std::stol(strJoin(timeStrs));
+  races.p2Distance = std::stol(strJoin(distanceStrs));
+  return races;
+}
+
+// The whole input is two lines, so streaming just means never holding more
+// than those two lines (and no line index) in memory
+Races streamRaces(const std::string &filename) {
+  LineReader reader(filename);
+  std::string_view view;
+  if (!reader.next(view)) {
+    throw std::runtime_error("Missing time line in " + filename);
+  }
+  std::string timeLine(view);
+  if (!reader.next(view)) {
+    throw std::runtime_error("Missing distance line in " + filename);
+  }
+  std::string distanceLine(view);
+  return parseRaces(timeLine, distanceLine);
+}
+
+int main(int argc, char *argv[]) {
+  auto start = std::chrono::high_resolution_clock::now();
+
+  Races races{};
+  if (argc > 1) {
+    // stream the given file instead of loading input.txt into memory
+    races = streamRaces(argv[1]);
+  } else {
+    std::vector<std::string> lines = fileLines<std::string>("input.txt");
+    races = parseRaces(lines[0], lines[1]);
+  }
 
   std::cout << "Part 1:\n";
-  std::cout << partOne(timeToDistance) << std::endl;
+  std::cout << partOne(races.timeToDistance) << std::endl;
   std::cout << "Part 2:\n";
-  std::cout << partTwo(p2Time, p2Distance) << std::endl;
+  std::cout << partTwo(races.p2Time, races.p2Distance) << std::endl;
 
   auto end = std::chrono::high_resolution_clock::now();
   auto duration =
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 std::map<char, int> cardValuesP1{
@@ -188,9 +189,10 @@ int partOne(const std::vector<std::string> &lines) {
 
   std::map<std::string, int, Comparator> handBids{};
   for (const auto &line : lines) {
-    std::vector<std::string> split = strSplit(line, " ");
-    int bid = std::stoi(split[1]);
-    handBids[split[0]] = bid;
+    auto split = strTokens(line, ' ').begin();
+    std::string hand(*split++);
+    int bid = strToTemplate<int>(*split);
+    handBids[hand] = bid;
   }
 
   int total = 0;
@@ -213,9 +215,10 @@ int partTwo(const std::vector<std::string> &lines) {
 
   std::map<std::string, int, Comparator> handBids{};
   for (const auto &line : lines) {
-    std::vector<std::string> split = strSplit(line, " ");
-    int bid = std::stoi(split[1]);
-    handBids[split[0]] = bid;
+    auto split = strTokens(line, ' ').begin();
+    std::string hand(*split++);
+    int bid = strToTemplate<int>(*split);
+    handBids[hand] = bid;
   }
 
   int total = 0;
@@ -1,13 +1,16 @@
 #include <file.h>
 #include <mathextras.h>
+#include <scan.h>
+#include <snapshot.h>
 
 #include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <map>
 #include <numeric>
-#include <regex>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 struct Node {
@@ -69,28 +72,56 @@ long partTwo(const Input& input) {
   return lcm<long>(allSteps);
 }
 
-int main() {
-  std::vector<std::string> lines = fileLines<std::string>("input.txt");
+constexpr char NODE_FORMAT[] = "{3} = ({3}, {3})";
 
-  auto start = std::chrono::high_resolution_clock::now();
+// bump when Input or parseInput change so old snapshots get ignored
+const uint32_t SNAPSHOT_VERSION = 1;
+
+void writeSnapshot(SnapshotWriter& out, const Node& node) {
+  out.write(node.left);
+  out.write(node.right);
+}
+
+void readSnapshot(SnapshotReader& in, Node& node) {
+  in.read(node.left);
+  in.read(node.right);
+}
+
+void writeSnapshot(SnapshotWriter& out, const Input& input) {
+  out.write(input.directions);
+  out.write(input.nodes);
+}
+
+void readSnapshot(SnapshotReader& in, Input& input) {
+  in.read(input.directions);
+  in.read(input.nodes);
+}
+
+Input parseInput(const MappedInput& file) {
+  const std::vector<std::string_view>& lines = file.lines();
 
   Input input;
-  input.directions = lines[0];
+  input.directions = std::string(lines[0]);
 
-  std::regex nodePattern(R"((...) = \((...), (...)\))");
   for (auto it = lines.begin() + 2; it != lines.end(); it++) {
-    std::string line = *it;
+    auto nodeMatch = scan<NODE_FORMAT>(*it);
+    if (!nodeMatch) {
+      throw std::runtime_error("No match for line: " + std::string(*it));
+    }
+    auto [from, left, right] = *nodeMatch;
 
-    std::smatch nodeMatch;
-    std::regex_match(line, nodeMatch, nodePattern);
+    Node node{std::string(left), std::string(right)};
+    input.nodes[std::string(from)] = node;
+  }
 
-    std::string from = nodeMatch[1].str();
-    std::string left = nodeMatch[2].str();
-    std::string right = nodeMatch[3].str();
+  return input;
+}
 
-    Node node{left, right};
-    input.nodes[from] = node;
-  }
+int main() {
+  auto start = std::chrono::high_resolution_clock::now();
+
+  // warm runs load the node table from input.txt.snap
+  Input input = cachedParse<Input>("input.txt", SNAPSHOT_VERSION, parseInput);
 
   std::cout << "Part 1:\n";
   std::cout << partOne(input) << std::endl;
@@ -4,6 +4,7 @@
 #include <chrono>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 std::pair<long, long> findNext(const std::vector<long>& seq) {
@@ -43,6 +44,14 @@ std::pair<long, long> findNext(const std::vector<long>& seq) {
   return std::make_pair(prev, next);
 }
 
+std::vector<long> parseSequence(std::string_view line) {
+  std::vector<long> sequence{};
+  for (std::string_view str : strTokens(line, ' ')) {
+    sequence.push_back(strToTemplate<long>(str));
+  }
+  return sequence;
+}
+
 long partOne(const std::vector<std::vector<long>>& sequences) {
   long total = 0;
 
@@ -63,25 +72,42 @@ long partTwo(const std::vector<std::vector<long>>& sequences) {
   return total;
 }
 
-int main() {
-  std::vector<std::string> lines = fileLines<std::string>("input.txt");
+// Both parts in a single pass over a file of any size
+std::pair<long, long> solveStreaming(const std::string& filename) {
+  long totalOne = 0;
+  long totalTwo = 0;
+  streamLines(filename, [&](std::string_view line) {
+    auto [prev, next] = findNext(parseSequence(line));
+    totalOne += next;
+    totalTwo += prev;
+  });
+  return {totalOne, totalTwo};
+}
 
+int main(int argc, char* argv[]) {
   auto start = std::chrono::high_resolution_clock::now();
 
-  std::vector<std::vector<long>> sequences{};
-  for (const auto& line : lines) {
-    std::vector<std::string> nums = strSplit(line, " ");
-    std::vector<long> sequence{};
-    for (const auto& str : nums) {
-      sequence.push_back(std::stoi(str));
+  if (argc > 1) {
+    // stream the given file instead of loading input.txt into memory
+    auto [one, two] = solveStreaming(argv[1]);
+    std::cout << "Part 1:\n";
+    std::cout << one << std::endl;
+    std::cout << "Part 2:\n";
+    std::cout << two << std::endl;
+  } else {
+    MappedInput input("input.txt");
+    const std::vector<std::string_view>& lines = input.lines();
+
+    std::vector<std::vector<long>> sequences{};
+    for (std::string_view line : lines) {
+      sequences.push_back(parseSequence(line));
     }
-    sequences.push_back(sequence);
-  }
 
-  std::cout << "Part 1:\n";
-  std::cout << partOne(sequences) << std::endl;
-  std::cout << "Part 2:\n";
-  std::cout << partTwo(sequences) << std::endl;
+    std::cout << "Part 1:\n";
+    std::cout << partOne(sequences) << std::endl;
+    std::cout << "Part 2:\n";
+    std::cout << partTwo(sequences) << std::endl;
+  }
 
   auto end = std::chrono::high_resolution_clock::now();
   auto duration =
@@ -1,12 +1,16 @@
+#include <components.h>
+#include <densegrid.h>
 #include <file.h>
 #include <grid.h>
+#include <search.h>
+#include <staticgrid.h>
 
 #include <algorithm>
 #include <chrono>
 #include <iostream>
-#include <queue>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 const std::map<char, std::set<Point2D>> pipeTypes{
@@ -18,11 +22,11 @@ const std::map<char, std::set<Point2D>> pipeTypes{
     {'F', std::set<Point2D>{DELTA_RIGHT, DELTA_DOWN}},
 };
 
-char startPipeType(const Grid2D<char> &grid, const Point2D &start) {
+template <typename Grid>
+char startPipeType(const Grid &grid, const Point2D &start) {
   // get deltas of adjacent pipes
   std::set<Point2D> deltas;
-  auto adjacent = grid.pointsAdjacent(start);
-  for (const auto &pair : adjacent) {
+  for (const auto &pair : grid.neighbors(start)) {
     if (pair.second == '.') {
       continue;
     }
@@ -48,14 +52,14 @@ char startPipeType(const Grid2D<char> &grid, const Point2D &start) {
 }
 
 // no bounds checking on the grid, beware
-std::map<Point2D, char> connectedPipes(const Grid2D<char> &grid,
-                                       const Point2D &point, char pipe) {
+template <typename Grid>
+std::map<Point2D, char> connectedPipes(const Grid &grid, const Point2D &point,
+                                       char pipe) {
   std::map<Point2D, char> connected{};
 
   if (pipe == 'S') {
     // find pipes that connect to this one
-    auto adjacent = grid.pointsAdjacent(point);
-    for (const auto &pair : adjacent) {
+    for (const auto &pair : grid.neighbors(point)) {
       if (pair.second == '.') {
         continue;
       }
@@ -81,7 +85,8 @@ std::map<Point2D, char> connectedPipes(const Grid2D<char> &grid,
   return connected;
 }
 
-int partOne(const Grid2D<char> &grid) {
+template <typename Grid>
+int partOne(const Grid &grid) {
   Point2D start{0, 0};
   for (const auto &pair : grid) {
     if (pair.second == 'S') {
@@ -90,35 +95,21 @@ int partOne(const Grid2D<char> &grid) {
     }
   }
 
-  std::map<Point2D, int> distance{};
-  int highestDistance = 0;
-
   // BFSin'
-  std::queue<Point2D> q;
-  q.push(start);
-  while (q.size() > 0) {
-    Point2D currentPoint = q.front();
-    q.pop();
-    char currentPipe = grid.at(currentPoint);
-    int currentDistance = distance[currentPoint];  // might be zero!
-    for (const auto &pair : connectedPipes(grid, currentPoint, currentPipe)) {
-      if (distance.count(pair.first) != 0) {
-        // visited
-        continue;
-      }
-      q.push(pair.first);
-      int newDistance = currentDistance + 1;
-      distance[pair.first] = newDistance;
-      if (newDistance > highestDistance) {
-        highestDistance = newDistance;
-      }
+  GraphSearch<Point2D, PointIndexer> search(
+      PointIndexer(grid.xBounds, grid.yBounds));
+  search.bfs({start}, [&](const Point2D &point, auto &&emit) {
+    for (const auto &pair : connectedPipes(grid, point, grid[point])) {
+      emit(pair.first);
     }
-  }
+  });
 
-  return highestDistance;
+  // BFS reaches the farthest pipe last
+  return search.distance(search.visited().back());
 }
 
-int partTwo(const Grid2D<char> &grid) {
+template <typename Grid>
+int partTwo(const Grid &grid) {
   // 1: find all pipes in the cycle
   Point2D start{0, 0};
   for (const auto &pair : grid) {
@@ -128,48 +119,38 @@ int partTwo(const Grid2D<char> &grid) {
     }
   }
 
-  std::map<Point2D, char> pipes;
-  Point2D bottomRight{0, 0};
-
   // BFSin'
-  std::queue<Point2D> cycleQ;
-  cycleQ.push(start);
-  while (cycleQ.size() > 0) {
-    Point2D currentPoint = cycleQ.front();
-    cycleQ.pop();
-    char currentPipe = grid.at(currentPoint);
+  GraphSearch<Point2D, PointIndexer> cycle(
+      PointIndexer(grid.xBounds, grid.yBounds));
+  cycle.bfs({start}, [&](const Point2D &point, auto &&emit) {
+    for (const auto &pair : connectedPipes(grid, point, grid[point])) {
+      emit(pair.first);
+    }
+  });
 
+  Point2D bottomRight{0, 0};
+  for (const Point2D &point : cycle.visited()) {
     // update max
-    if (currentPoint.x > bottomRight.x) {
-      bottomRight.x = currentPoint.x;
-    }
-    if (currentPoint.y > bottomRight.y) {
-      bottomRight.y = currentPoint.y;
+    if (point.x > bottomRight.x) {
+      bottomRight.x = point.x;
     }
-
-    // enqueue neighbors
-    for (const auto &pair : connectedPipes(grid, currentPoint, currentPipe)) {
-      if (pipes.count(pair.first) != 0) {
-        // visited
-        continue;
-      }
-      cycleQ.push(pair.first);
-      pipes[pair.first] = pair.second;
+    if (point.y > bottomRight.y) {
+      bottomRight.y = point.y;
     }
   }
 
   // 2: make a new grid that is 3x the old grid's size
-  Grid2D<char> bigGrid(true);
   Point2D bigBottomRight = bottomRight * 3 + DELTA_DOWN_RIGHT * 2;
   // fill large grid with .'s to start
-  for (int y = 0; y <= bigBottomRight.y; y++) {
-    for (int x = 0; x <= bigBottomRight.x; x++) {
-      bigGrid[Point2D{x, y}] = '.';
-    }
-  }
+  DenseGrid2D<char> bigGrid(Range<int>{0, bigBottomRight.x},
+                            Range<int>{0, bigBottomRight.y}, '.');
+  bigGrid.excludeDiagonals = true;
 
   // put in the pipes that are part of our cycle
-  for (const auto &pair : pipes) {
+  for (const auto &pair : grid) {
+    if (!cycle.reached(pair.first)) {
+      continue;
+    }
     Point2D cellTopLeft = pair.first * 3;
     Point2D cellCenter = cellTopLeft + DELTA_DOWN_RIGHT;
 
@@ -190,32 +171,16 @@ int partTwo(const Grid2D<char> &grid) {
     }
   }
 
-  // 3: start at 0,0 and fill with new symbol
-  std::queue<Point2D> fillQ;
-  fillQ.push(Point2D{0, 0});
-  while (fillQ.size() > 0) {
-    Point2D curr = fillQ.front();
-    fillQ.pop();
-
-    if (bigGrid.at(curr) != '.') {
-      // don't do anything if this spot is not empty or is already marked
-      continue;
-    }
-
-    // mark this spot
-    bigGrid[curr] = 'O';
-
-    // enqueue neighbors
-    for (const auto &pair : bigGrid.pointsAdjacent(curr)) {
-      fillQ.push(pair.first);
-    }
-  }
+  // 3: label the empty space. the outside is everything that reaches the edge
+  // of the grid
+  ComponentLabels empty(bigGrid, [](char cell) { return cell == '.'; });
 
-  // 4 count .'s that are in the middle of 3x3 cells
+  // 4 count enclosed .'s that are in the middle of 3x3 cells
   int count = 0;
   for (int y = 1; y < bigBottomRight.y; y += 3) {
     for (int x = 1; x < bigBottomRight.x; x += 3) {
-      if (bigGrid[Point2D{x, y}] == '.') {
+      int label = empty.label(Point2D{x, y});
+      if (label != ComponentLabels::NONE && !empty.touchesBorder(label)) {
         count++;
       }
     }
@@ -224,17 +189,20 @@ int partTwo(const Grid2D<char> &grid) {
 }
 
 int main() {
-  std::vector<std::string> lines = fileLines<std::string>("input.txt");
+  MappedInput input("input.txt");
+  const std::vector<std::string_view> &lines = input.lines();
 
   auto start = std::chrono::high_resolution_clock::now();
 
-  auto grid = linesToGrid(lines);
-  grid.excludeDiagonals = true;
+  // the real input is 140x140, which gets a StaticGrid2D
+  withLinesGrid(lines, [](auto &grid) {
+    grid.excludeDiagonals = true;
 
-  std::cout << "Part 1:\n";
-  std::cout << partOne(grid) << std::endl;
-  std::cout << "Part 2:\n";
-  std::cout << partTwo(grid) << std::endl;
+    std::cout << "Part 1:\n";
+    std::cout << partOne(grid) << std::endl;
+    std::cout << "Part 2:\n";
+    std::cout << partTwo(grid) << std::endl;
+  });
 
   auto end = std::chrono::high_resolution_clock::now();
   auto duration =
@@ -1,3 +1,4 @@
+#include <chargridview.h>
 #include <file.h>
 #include <grid.h>
 
@@ -5,44 +6,33 @@
 #include <iostream>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
-long solution(const std::vector<std::string> &lines, int timeDilation) {
-  int width = lines[0].length();
-  int height = lines.size();
-
+long solution(const CharGridView &grid, int timeDilation) {
   // find all empty rows and columns
   std::set<int> emptyRows{};
-  for (int r = 0; r < height; r++) {
-    const auto &line = lines[r];
-    bool empty = true;
-    for (char c : line) {
-      if (c != '.') {
-        empty = false;
-        break;
-      }
-    }
-    if (empty) {
-      emptyRows.insert(r);
+  for (int y = grid.yBounds.min; y <= grid.yBounds.max; y++) {
+    if (grid.line(y).find_first_not_of('.') == std::string_view::npos) {
+      emptyRows.insert(y);
     }
   }
 
   std::set<int> emptyCols{};
-  for (int c = 0; c < width; c++) {
+  for (int x = grid.xBounds.min; x <= grid.xBounds.max; x++) {
     bool empty = true;
-    for (const auto &line : lines) {
-      if (line[c] != '.') {
+    for (char c : grid.colView(x)) {
+      if (c != '.') {
         empty = false;
         break;
       }
     }
     if (empty) {
-      emptyCols.insert(c);
+      emptyCols.insert(x);
     }
   }
 
   // enumerate all galaxies
-  Grid2D<char> grid = linesToGrid(lines);
   std::set<Point2D> galaxies;
   for (const auto &pair : grid) {
     if (pair.second == '#') {
@@ -79,23 +69,24 @@ long solution(const std::vector<std::string> &lines, int timeDilation) {
   return totalDistance;
 }
 
-int partOne(const std::vector<std::string> &lines) {
-  return solution(lines, 1);
+int partOne(const CharGridView &grid) {
+  return solution(grid, 1);
 }
 
-long partTwo(const std::vector<std::string> &lines) {
-  return solution(lines, 999999);
+long partTwo(const CharGridView &grid) {
+  return solution(grid, 999999);
 }
 
 int main() {
-  std::vector<std::string> lines = fileLines<std::string>("input.txt");
+  MappedInput input("input.txt");
+  CharGridView grid(input);
 
   auto start = std::chrono::high_resolution_clock::now();
 
   std::cout << "Part 1:\n";
-  std::cout << partOne(lines) << std::endl;
+  std::cout << partOne(grid) << std::endl;
   std::cout << "Part 2:\n";
-  std::cout << partTwo(lines) << std::endl;
+  std::cout << partTwo(grid) << std::endl;
 
   auto end = std::chrono::high_resolution_clock::now();
   auto duration =
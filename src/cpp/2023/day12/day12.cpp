@@ -8,6 +8,7 @@
 #include <map>
 #include <stack>
 #include <string>
+#include <string_view>
 #include <vector>
 
 struct Row {
@@ -120,20 +121,21 @@ int main() {
   std::vector<Row> partOneRows;
   std::vector<Row> partTwoRows;
   for (const auto& line : lines) {
-    std::vector<std::string> split = strSplit(line, " ");
-    std::vector<std::string> groupStrs = strSplit(split[1], ",");
+    auto split = strTokens(line, ' ').begin();
+    std::string springs(*split++);
+    std::string_view groupStrs = *split;
 
     Row partOneRow{};
-    partOneRow.springs = split[0];
+    partOneRow.springs = springs;
     partOneRow.groups = std::vector<int>{};
-    for (const auto& str : groupStrs) {
-      partOneRow.groups.push_back(std::stoi(str));
+    for (std::string_view str : strTokens(groupStrs, ',')) {
+      partOneRow.groups.push_back(strToTemplate<int>(str));
     }
     partOneRows.push_back(partOneRow);
 
     Row partTwoRow{};
-    partTwoRow.springs = split[0] + "?" + split[0] + "?" + split[0] + "?" +
-                         split[0] + "?" + split[0];
+    partTwoRow.springs = springs + "?" + springs + "?" + springs + "?" +
+                         springs + "?" + springs;
     partTwoRow.groups = std::vector<int>{};
     for (int i = 0; i < 5; i++) {
       for (const auto& g : partOneRow.groups) {
@@ -1,19 +1,21 @@
+#include <chargridview.h>
 #include <file.h>
 
 #include <chrono>
 #include <iostream>
 #include <limits>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "grid.h"
 
-int totalMirrorRowDiff(const Grid2D<char> &grid, int y, int maxDiff) {
+int totalMirrorRowDiff(const CharGridView &grid, int y, int maxDiff) {
   int diff = 0;
   int yMirror = y + 1;
   while (y >= 0 && yMirror <= grid.yBounds.max) {
-    auto yRow = grid.row(y);
-    auto yMirrorRow = grid.row(yMirror);
+    auto yRow = grid.rowView(y);
+    auto yMirrorRow = grid.rowView(yMirror);
 
     auto yRowIt = yRow.begin();
     auto yMirrorRowIt = yMirrorRow.begin();
@@ -36,12 +38,12 @@ int totalMirrorRowDiff(const Grid2D<char> &grid, int y, int maxDiff) {
   return diff;
 }
 
-int totalMirrorColDiff(const Grid2D<char> &grid, int x, int maxDiff) {
+int totalMirrorColDiff(const CharGridView &grid, int x, int maxDiff) {
   int diff = 0;
   int xMirror = x + 1;
   while (x >= 0 && xMirror <= grid.xBounds.max) {
-    auto xCol = grid.col(x);
-    auto xMirrorCol = grid.col(xMirror);
+    auto xCol = grid.colView(x);
+    auto xMirrorCol = grid.colView(xMirror);
 
     auto xColIt = xCol.begin();
     auto xMirrorColIt = xMirrorCol.begin();
@@ -65,11 +67,11 @@ int totalMirrorColDiff(const Grid2D<char> &grid, int x, int maxDiff) {
 }
 
 // pass the upper row as y
-bool isMirrorRow(const Grid2D<char> &grid, int y) {
+bool isMirrorRow(const CharGridView &grid, int y) {
   int yMirror = y + 1;
   while (y >= 0 && yMirror <= grid.yBounds.max) {
-    auto yRow = grid.row(y);
-    auto yMirrorRow = grid.row(yMirror);
+    auto yRow = grid.rowView(y);
+    auto yMirrorRow = grid.rowView(yMirror);
 
     if (yRow != yMirrorRow) {
       // mirror broken
@@ -85,11 +87,11 @@ bool isMirrorRow(const Grid2D<char> &grid, int y) {
 }
 
 // pass the left col as x
-bool isMirrorCol(const Grid2D<char> &grid, int x) {
+bool isMirrorCol(const CharGridView &grid, int x) {
   int xMirror = x + 1;
   while (x >= 0 && xMirror <= grid.xBounds.max) {
-    auto xCol = grid.col(x);
-    auto xMirrorCol = grid.col(xMirror);
+    auto xCol = grid.colView(x);
+    auto xMirrorCol = grid.colView(xMirror);
 
     if (xCol != xMirrorCol) {
       // mirror broken
@@ -104,7 +106,8 @@ bool isMirrorCol(const Grid2D<char> &grid, int x) {
   return true;
 }
 
-int calculateSummary(const std::vector<Grid2D<char>> &grids, int desiredDiff) {
+int calculateSummary(const std::vector<CharGridView> &grids,
+                     int desiredDiff) {
   int summary = 0;
 
   for (const auto &grid : grids) {
@@ -126,32 +129,34 @@ int calculateSummary(const std::vector<Grid2D<char>> &grids, int desiredDiff) {
   return summary;
 }
 
-int partOne(const std::vector<Grid2D<char>> &grids) {
+int partOne(const std::vector<CharGridView> &grids) {
   return calculateSummary(grids, 0);
 }
 
-int partTwo(const std::vector<Grid2D<char>> &grids) {
+int partTwo(const std::vector<CharGridView> &grids) {
   return calculateSummary(grids, 1);
 }
 
 int main() {
-  std::vector<std::string> lines = fileLines<std::string>("input.txt");
+  MappedInput input("input.txt");
+  const std::vector<std::string_view> &lines = input.lines();
 
   auto start = std::chrono::high_resolution_clock::now();
 
-  std::vector<Grid2D<char>> grids{};
-  std::vector<std::string> currentLines{};
-  for (const auto &line : lines) {
-    if (line == "") {
-      auto grid = linesToGrid(currentLines);
-      grids.push_back(grid);
-      currentLines.clear();
-    } else {
-      currentLines.push_back(line);
+  // each pattern is a view over its own lines of the input
+  std::vector<CharGridView> grids{};
+  size_t first = 0;
+  for (size_t i = 0; i <= lines.size(); i++) {
+    if (i < lines.size() && lines[i] != "") {
+      continue;
     }
+    if (i > first) {
+      const char *begin = lines[first].data();
+      const char *end = lines[i - 1].data() + lines[i - 1].size();
+      grids.emplace_back(std::string_view(begin, end - begin));
+    }
+    first = i + 1;
   }
-  auto grid = linesToGrid(currentLines);
-  grids.push_back(grid);
 
   std::cout << "Part 1:\n";
   std::cout << partOne(grids) << std::endl;
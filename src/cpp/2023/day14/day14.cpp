@@ -1,14 +1,16 @@
+#include <densegrid.h>
 #include <file.h>
 #include <grid.h>
 
 #include <chrono>
 #include <iostream>
-#include <sstream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
-// returns a "hash" of round boulder locations
-std::string slideRocks(Grid2D<char> &grid, const Point2D &delta) {
+void slideRocks(DenseGrid2D<char> &grid, const Point2D &delta) {
   // std::cout << "Before" << std::endl;
   // grid.print();
 
@@ -48,20 +50,21 @@ std::string slideRocks(Grid2D<char> &grid, const Point2D &delta) {
     loopX = -1;
   }
 
-  std::ostringstream oss;
+  // read through a const reference so only actual writes touch the grid's
+  // hash
+  const DenseGrid2D<char> &cells = grid;
 
   for (int y = initialY; y != finalY; y += loopY) {
     for (int x = initialX; x != finalX; x += loopX) {
       Point2D here{x, y};
 
-      if (grid[here] == 'O') {
+      if (cells[here] == 'O') {
         // remove the rock from its original place
         grid[here] = '.';
         // travel in delta direction until we find something that would block
-        // this rock
+        // this rock; the '#' padding blocks it at the edges
         here = here + delta;
-        while (grid.yBounds.contains(here.y) && grid.xBounds.contains(here.x) &&
-               grid[here] == '.') {
+        while (cells[here] == '.') {
           here = here + delta;
         }
         // here is slightly too far; move it back one space to be where the rock
@@ -69,19 +72,15 @@ std::string slideRocks(Grid2D<char> &grid, const Point2D &delta) {
         here = here - delta;
         // place the rock
         grid[here] = 'O';
-
-        // add the rock location to the stream
-        oss << here.x << "," << here.y << ";";
       }
     }
   }
 
   // std::cout << "After" << std::endl;
   // grid.print();
-  return oss.str();
 }
 
-int northLoad(const Grid2D<char> &grid) {
+int northLoad(const DenseGrid2D<char> &grid) {
   int totalLoad = 0;
   for (const auto &pair : grid) {
     if (pair.second == 'O') {
@@ -92,16 +91,15 @@ int northLoad(const Grid2D<char> &grid) {
   return totalLoad;
 }
 
-int partOne(const Grid2D<char> &original) {
-  auto grid = original;
+int partOne(DenseGrid2D<char> grid) {
   slideRocks(grid, DELTA_UP);
   return northLoad(grid);
 }
 
-int partTwo(const Grid2D<char> &original) {
-  auto grid = original;
+int partTwo(DenseGrid2D<char> grid) {
+  grid.enableHashing();
 
-  std::map<std::string, int> cycleHashes{};
+  std::unordered_map<GridHash, int> cycleHashes{};
 
   bool timeTraveled = false;
   for (int cycles = 0; cycles < 1000000000; cycles++) {
@@ -111,7 +109,8 @@ int partTwo(const Grid2D<char> &original) {
     slideRocks(grid, DELTA_UP);
     slideRocks(grid, DELTA_LEFT);
     slideRocks(grid, DELTA_DOWN);
-    auto hash = slideRocks(grid, DELTA_RIGHT);
+    slideRocks(grid, DELTA_RIGHT);
+    GridHash hash = grid.hash();
 
     // int load = northLoad(grid);
     // std::cout << "After cycle " << cycles << " (load " << load << ")"
@@ -139,16 +138,20 @@ int partTwo(const Grid2D<char> &original) {
 }
 
 int main() {
-  std::vector<std::string> lines = fileLines<std::string>("input.txt");
+  MappedInput input("input.txt");
+  const std::vector<std::string_view> &lines = input.lines();
 
   auto start = std::chrono::high_resolution_clock::now();
 
-  auto grid = linesToGrid(lines);
+  auto grid = linesToGrid<DenseGrid2D<char>>(lines);
+  // a wall all the way around stops rocks at the edges
+  grid.pad('#');
 
   std::cout << "Part 1:\n";
   std::cout << partOne(grid) << std::endl;
   std::cout << "Part 2:\n";
-  std::cout << partTwo(grid) << std::endl;
+  // last use, so part two can have the original
+  std::cout << partTwo(std::move(grid)) << std::endl;
 
   auto end = std::chrono::high_resolution_clock::now();
   auto duration =
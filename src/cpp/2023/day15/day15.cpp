@@ -5,9 +5,10 @@
 #include <iostream>
 #include <list>
 #include <string>
+#include <string_view>
 #include <vector>
 
-int calculateHash(const std::string& string) {
+int calculateHash(std::string_view string) {
   int currentValue = 0;
   for (char c : string) {
     currentValue += c;
@@ -17,7 +18,7 @@ int calculateHash(const std::string& string) {
   return currentValue;
 }
 
-int partOne(const std::vector<std::string>& strings) {
+int partOne(const std::vector<std::string_view>& strings) {
   int sum = 0;
 
   for (const auto& string : strings) {
@@ -28,7 +29,8 @@ int partOne(const std::vector<std::string>& strings) {
 }
 
 struct Lens {
-  std::string label;
+  // points into the mapped input
+  std::string_view label;
   int focalLength;
 };
 
@@ -36,15 +38,15 @@ struct Box {
   std::list<Lens> lenses;
 };
 
-int partTwo(const std::vector<std::string>& steps) {
+int partTwo(const std::vector<std::string_view>& steps) {
   std::vector<Box> boxes{};
   boxes.resize(256);
 
   for (const auto& step : steps) {
-    if (size_t pos = step.find('='); pos != std::string::npos) {
+    if (size_t pos = step.find('='); pos != std::string_view::npos) {
       // equals operator
-      std::string label = step.substr(0, pos);
-      int focalLength = std::stoi(step.substr(pos + 1));
+      std::string_view label = step.substr(0, pos);
+      int focalLength = strToTemplate<int>(step.substr(pos + 1));
 
       // insert/replace lens with focal length
       int hash = calculateHash(label);
@@ -67,7 +69,7 @@ int partTwo(const std::vector<std::string>& steps) {
       }
     } else {
       // dash operator
-      std::string label = step.substr(0, step.length() - 1);
+      std::string_view label = step.substr(0, step.length() - 1);
 
       // remove all lenses with this label
       int hash = calculateHash(label);
@@ -97,11 +99,13 @@ int partTwo(const std::vector<std::string>& steps) {
 }
 
 int main() {
-  std::vector<std::string> lines = fileLines<std::string>("input.txt");
+  MappedInput input("input.txt");
+  const std::vector<std::string_view>& lines = input.lines();
 
   auto start = std::chrono::high_resolution_clock::now();
 
-  std::vector<std::string> strings = strSplit(lines[0], ",");
+  StringTokenizer tokens = strTokens(lines[0], ',');
+  std::vector<std::string_view> strings(tokens.begin(), tokens.end());
 
   std::cout << "Part 1:\n";
   std::cout << partOne(strings) << std::endl;
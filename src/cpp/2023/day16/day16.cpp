@@ -1,12 +1,14 @@
+#include <bitgrid.h>
+#include <chargridview.h>
 #include <file.h>
 #include <grid.h>
+#include <search.h>
 
 #include <algorithm>
 #include <chrono>
 #include <iostream>
-#include <set>
-#include <stack>
 #include <string>
+#include <string_view>
 #include <vector>
 
 struct Beam {
@@ -27,8 +29,20 @@ std::map<Point2D, Point2D> backMirrorDirections{
     {DELTA_RIGHT, DELTA_DOWN},
 };
 
-void printEnergized(const Grid2D<std::set<Point2D>> &energized,
-                    const Grid2D<char> &grid) {
+// index into the per-direction visited grids
+int directionIndex(const Point2D &direction) {
+  if (direction == DELTA_UP) {
+    return 0;
+  } else if (direction == DELTA_DOWN) {
+    return 1;
+  } else if (direction == DELTA_LEFT) {
+    return 2;
+  } else {
+    return 3;
+  }
+}
+
+void printEnergized(const BitGrid &energized, const CharGridView &grid) {
   std::cout << "\033[H\033[J";
   int currentY = grid.begin()->first.y;
   for (const auto &pair : grid) {
@@ -37,8 +51,7 @@ void printEnergized(const Grid2D<std::set<Point2D>> &energized,
       currentY = pair.first.y;
     }
 
-    if (auto it = energized.find(pair.first);
-        it != energized.end() && it->second.size() > 0) {
+    if (energized[pair.first]) {
       std::cout << '#';
     } else {
       std::cout << '.';
@@ -47,99 +60,105 @@ void printEnergized(const Grid2D<std::set<Point2D>> &energized,
   std::cout << std::endl << std::endl;
 }
 
-int simulate(const Grid2D<char> &grid, Beam init) {
-  Grid2D<std::set<Point2D>> energized{};
+// numbers (location, direction) states for the search
+class BeamIndexer {
+ public:
+  BeamIndexer(const CharGridView &grid)
+      : points(grid.xBounds, grid.yBounds) {}
 
-  std::stack<Beam> beams{};
-  beams.push(init);
-
-  while (beams.size() > 0) {
-    auto curr = beams.top();
-    beams.pop();
+  size_t operator()(const Beam &beam) const {
+    return this->points(beam.location) * 4 + directionIndex(beam.direction);
+  }
+  size_t size() const { return this->points.size() * 4; }
 
-    if (auto it = energized.find(curr.location);
-        it != energized.end() && it->second.count(curr.direction) > 0) {
-      // already been here
-      continue;
-    } else {
-      // haven't been here
-      energized[curr.location].insert(curr.direction);
-    }
-    // printEnergized(energized, grid);
-    // std::cout << std::endl;
-
-    // direction changin' / splittin'
-    if (grid.at(curr.location) == '/') {
-      curr.direction = forwardMirrorDirections[curr.direction];
-    } else if (grid.at(curr.location) == '\\') {
-      curr.direction = backMirrorDirections[curr.direction];
-    } else if (grid.at(curr.location) == '-') {
-      if (curr.direction == DELTA_UP || curr.direction == DELTA_DOWN) {
-        // send this beam right and make a new one going left
-        Beam other{curr.location, DELTA_LEFT};
-        beams.push(other);
-
-        curr.direction = DELTA_RIGHT;
-      }
-      // left/right: treat as empty
-    } else if (grid.at(curr.location) == '|') {
-      if (curr.direction == DELTA_LEFT || curr.direction == DELTA_RIGHT) {
-        // send this beam up and make a new one going down
-        Beam other{curr.location, DELTA_DOWN};
-        beams.push(other);
-
-        curr.direction = DELTA_UP;
-      }
-      // up/down: treat as empty
-    }
-    // else: empty space
+ private:
+  PointIndexer points;
+};
 
-    Point2D next = curr.location + curr.direction;
+using BeamSearch = GraphSearch<Beam, BeamIndexer>;
 
-    if (!grid.inBounds(next)) {
-      // good bye beam
-      continue;
+// calls emit with every beam leaving this beam's cell
+template <typename Emit>
+void nextBeams(const CharGridView &grid, const Beam &beam, Emit &emit) {
+  auto move = [&](const Point2D &direction) {
+    Point2D next = beam.location + direction;
+    if (grid.inBounds(next)) {
+      emit(Beam{next, direction});
     }
+    // else: good bye beam
+  };
+
+  // direction changin' / splittin'
+  char cell = grid[beam.location];
+  if (cell == '/') {
+    move(forwardMirrorDirections[beam.direction]);
+  } else if (cell == '\\') {
+    move(backMirrorDirections[beam.direction]);
+  } else if (cell == '-' &&
+             (beam.direction == DELTA_UP || beam.direction == DELTA_DOWN)) {
+    // split left and right
+    move(DELTA_LEFT);
+    move(DELTA_RIGHT);
+  } else if (cell == '|' &&
+             (beam.direction == DELTA_LEFT || beam.direction == DELTA_RIGHT)) {
+    // split up and down
+    move(DELTA_UP);
+    move(DELTA_DOWN);
+  } else {
+    // empty space, or a splitter hit end-on
+    move(beam.direction);
+  }
+}
+
+int simulate(const CharGridView &grid, BeamSearch &search, Beam init) {
+  search.bfs({init}, [&](const Beam &beam, auto &&emit) {
+    nextBeams(grid, beam, emit);
+  });
 
-    curr.location = next;
-    beams.push(curr);
+  BitGrid energized(grid.xBounds, grid.yBounds);
+  for (const Beam &beam : search.visited()) {
+    energized.set(beam.location);
   }
+  // printEnergized(energized, grid);
 
-  return energized.size();
+  return energized.count();
 }
 
-int partOne(const Grid2D<char> &grid) {
-  return simulate(grid, Beam{{0, 0}, DELTA_RIGHT});
+int partOne(const CharGridView &grid) {
+  BeamSearch search{BeamIndexer(grid)};
+  return simulate(grid, search, Beam{{0, 0}, DELTA_RIGHT});
 }
 
-int partTwo(const Grid2D<char> &grid) {
+int partTwo(const CharGridView &grid) {
+  // one search reused for every starting beam
+  BeamSearch search{BeamIndexer(grid)};
   int max = 0;
 
   // top aiming down
   for (int x = grid.xBounds.min; x <= grid.xBounds.max; x++) {
     Beam init{{x, grid.yBounds.min}, DELTA_DOWN};
-    int result = simulate(grid, init);
+    int result = simulate(grid, search, init);
     max = std::max(result, max);
   }
 
   // bottom aiming up
   for (int x = grid.xBounds.min; x <= grid.xBounds.max; x++) {
     Beam init{{x, grid.yBounds.max}, DELTA_UP};
-    int result = simulate(grid, init);
+    int result = simulate(grid, search, init);
     max = std::max(result, max);
   }
 
   // left aiming right
   for (int y = grid.yBounds.min; y <= grid.yBounds.max; y++) {
     Beam init{{grid.xBounds.min, y}, DELTA_RIGHT};
-    int result = simulate(grid, init);
+    int result = simulate(grid, search, init);
     max = std::max(result, max);
   }
 
   // right aiming left
   for (int y = grid.yBounds.min; y <= grid.yBounds.max; y++) {
     Beam init{{grid.xBounds.max, y}, DELTA_LEFT};
-    int result = simulate(grid, init);
+    int result = simulate(grid, search, init);
     max = std::max(result, max);
   }
 
@@ -147,11 +166,11 @@ int partTwo(const Grid2D<char> &grid) {
 }
 
 int main() {
-  std::vector<std::string> lines = fileLines<std::string>("input.txt");
+  MappedInput input("input.txt");
 
   auto start = std::chrono::high_resolution_clock::now();
 
-  auto grid = linesToGrid(lines);
+  CharGridView grid(input);
 
   std::cout << "Part 1:\n";
   std::cout << partOne(grid) << std::endl;
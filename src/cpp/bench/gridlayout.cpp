@@ -0,0 +1,150 @@
+// Row-major vs tiled vs Morton DenseGrid2D storage on the grid days' access
+// patterns, using the day14 input tiled out to 10x-100x its size. Build it like
+// any day and run it from src/cpp:
+//   g++ -O2 -std=c++17 -I utils utils/*.cpp bench/gridlayout.cpp
+// and pass scale factors to override the default of 10 30 100.
+
+#include <densegrid.h>
+#include <file.h>
+#include <grid.h>
+#include <gridlayout.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+const std::string INPUT_FILE = "2023/day14/input.txt";
+
+template <typename Grid>
+Grid tiledInput(const std::vector<std::string_view> &lines, int scale) {
+  int width = lines[0].length();
+  int height = lines.size();
+  Grid grid(Range<int>{0, width * scale - 1},
+            Range<int>{0, height * scale - 1});
+  for (int y = 0; y <= grid.yBounds.max; y++) {
+    for (int x = 0; x <= grid.xBounds.max; x++) {
+      grid[{x, y}] = lines[y % height][x % width];
+    }
+  }
+  return grid;
+}
+
+// day14: roll every round rock as far as it goes in one direction
+template <typename Grid>
+void tilt(Grid &grid, const Point2D &delta) {
+  bool vertical = delta.x == 0;
+  Range<int> outer = vertical ? grid.xBounds : grid.yBounds;
+  Range<int> inner = vertical ? grid.yBounds : grid.xBounds;
+  int step = vertical ? -delta.y : -delta.x;
+  int first = step > 0 ? inner.min : inner.max;
+  int last = step > 0 ? inner.max : inner.min;
+
+  for (int o = outer.min; o <= outer.max; o++) {
+    int stop = first;
+    for (int i = first; i != last + step; i += step) {
+      Point2D here = vertical ? Point2D{o, i} : Point2D{i, o};
+      char cell = grid[here];
+      if (cell == '#') {
+        stop = i + step;
+      } else if (cell == 'O') {
+        grid[here] = '.';
+        grid[vertical ? Point2D{o, stop} : Point2D{stop, o}] = 'O';
+        stop += step;
+      }
+    }
+  }
+}
+
+template <typename Grid>
+long spinCycle(Grid grid) {
+  for (const auto &delta : {DELTA_UP, DELTA_LEFT, DELTA_DOWN, DELTA_RIGHT}) {
+    tilt(grid, delta);
+  }
+
+  long load = 0;
+  for (int y = grid.yBounds.min; y <= grid.yBounds.max; y++) {
+    for (int x = grid.xBounds.min; x <= grid.xBounds.max; x++) {
+      if (grid[{x, y}] == 'O') {
+        load += grid.yBounds.max - y + 1;
+      }
+    }
+  }
+  return load;
+}
+
+// day13: compare every pair of neighboring columns
+template <typename Grid>
+long mirrorColDiffs(const Grid &grid) {
+  long diffs = 0;
+  auto previous = grid.col(grid.xBounds.min);
+  for (int x = grid.xBounds.min + 1; x <= grid.xBounds.max; x++) {
+    auto current = grid.col(x);
+    for (size_t i = 0; i < current.size(); i++) {
+      diffs += current[i] != previous[i];
+    }
+    previous = std::move(current);
+  }
+  return diffs;
+}
+
+// day16: beams running straight down every column
+template <typename Grid>
+long columnWalks(const Grid &grid) {
+  long hits = 0;
+  for (int x = grid.xBounds.min; x <= grid.xBounds.max; x++) {
+    for (int y = grid.yBounds.min; y <= grid.yBounds.max; y++) {
+      hits += grid[{x, y}] != '.';
+    }
+  }
+  return hits;
+}
+
+template <typename Fn>
+void report(const std::string &label, Fn fn) {
+  auto start = std::chrono::high_resolution_clock::now();
+  long result = fn();
+  auto end = std::chrono::high_resolution_clock::now();
+
+  double ms = std::chrono::duration<double, std::milli>(end - start).count();
+  std::cout << "  " << std::left << std::setw(28) << label << ": "
+            << std::setw(10) << ms << "ms (" << result << ")" << std::endl;
+}
+
+template <typename Layout>
+void benchLayout(const std::string &name,
+                 const std::vector<std::string_view> &lines, int scale) {
+  auto grid = tiledInput<DenseGrid2D<char, Layout>>(lines, scale);
+  report(name + " spin cycle", [&] { return spinCycle(grid); });
+  report(name + " mirror col diffs", [&] { return mirrorColDiffs(grid); });
+  report(name + " column walks", [&] { return columnWalks(grid); });
+}
+
+int main(int argc, char *argv[]) {
+  std::vector<int> scales{10, 30, 100};
+  if (argc > 1) {
+    scales.clear();
+    for (int i = 1; i < argc; i++) {
+      scales.push_back(std::stoi(argv[i]));
+    }
+  }
+
+  MappedInput input(INPUT_FILE);
+  if (!input.isOpen()) {
+    return 1;
+  }
+  const std::vector<std::string_view> &lines = input.lines();
+
+  for (int scale : scales) {
+    std::cout << scale << "x (" << lines[0].length() * scale << " x "
+              << lines.size() * scale << "):" << std::endl;
+    benchLayout<RowMajorLayout>("row-major", lines, scale);
+    benchLayout<TiledLayout<8>>("tiled 8x8", lines, scale);
+    benchLayout<TiledLayout<64>>("tiled 64x64", lines, scale);
+    benchLayout<MortonLayout>("morton", lines, scale);
+  }
+
+  return 0;
+}
@@ -0,0 +1,92 @@
+// Throughput of the typed line parsers in file.h against the stringstream
+// approach fileLines used to take. Build it like any day:
+//   g++ -O2 -std=c++17 -I utils utils/*.cpp bench/parsing.cpp
+// and pass a line count to override the default of 2,000,000.
+
+#include <file.h>
+#include <stringextras.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+const std::string NUMBERS_FILE = "bench-numbers.txt";
+const std::string RECORDS_FILE = "bench-records.txt";
+
+// What fileLines<T> did before it went through from_chars
+template <typename T>
+std::vector<T> legacyFileLines(const std::string& filename) {
+  std::ifstream input_file(filename);
+  std::vector<T> lines{};
+  std::string line;
+  while (std::getline(input_file, line)) {
+    std::stringstream ss(line);
+    T casted;
+    ss >> casted;
+    lines.push_back(casted);
+  }
+  return lines;
+}
+
+// What day05 did for each mapping row before parseRecord
+std::vector<std::tuple<long, long, long>> legacyFileRecords(
+    const std::string& filename) {
+  std::vector<std::tuple<long, long, long>> records{};
+  std::ifstream input_file(filename);
+  std::string line;
+  while (std::getline(input_file, line)) {
+    std::vector<std::string> numsVec = strSplit(line, " ");
+    records.push_back({std::stol(numsVec[0]), std::stol(numsVec[1]),
+                       std::stol(numsVec[2])});
+  }
+  return records;
+}
+
+template <typename Fn>
+void report(const std::string& label, long lineCount, Fn fn) {
+  auto start = std::chrono::high_resolution_clock::now();
+  auto result = fn();
+  auto end = std::chrono::high_resolution_clock::now();
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  std::cout << std::left << std::setw(32) << label << ": "
+            << (long)(lineCount / seconds) << " lines/s (" << result.size()
+            << " lines in " << seconds * 1000 << "ms)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+  long lineCount = argc > 1 ? std::stol(argv[1]) : 2000000;
+
+  std::mt19937_64 rng(2023);
+  std::uniform_int_distribution<long> dist(0, 4000000000L);
+  {
+    std::ofstream numbers(NUMBERS_FILE);
+    std::ofstream records(RECORDS_FILE);
+    for (long i = 0; i < lineCount; i++) {
+      numbers << dist(rng) << '\n';
+      records << dist(rng) << ' ' << dist(rng) << ' ' << dist(rng) << '\n';
+    }
+  }
+
+  report("stringstream fileLines<long>", lineCount,
+         [] { return legacyFileLines<long>(NUMBERS_FILE); });
+  report("from_chars fileLines<long>", lineCount,
+         [] { return fileLines<long>(NUMBERS_FILE); });
+  report("strSplit + stol records", lineCount,
+         [] { return legacyFileRecords(RECORDS_FILE); });
+  report("fileRecords<long, long, long>", lineCount, [] {
+    return fileRecords<long, long, long>(RECORDS_FILE, ' ');
+  });
+
+  std::remove(NUMBERS_FILE.c_str());
+  std::remove(RECORDS_FILE.c_str());
+
+  return 0;
+}
@@ -0,0 +1,121 @@
+// std::priority_queue vs the GraphSearch queues (priorityqueue.h) running
+// Dijkstra across generated grids with cell costs 1-9, like the usual "lowest
+// total risk" puzzles. Build it like any day:
+//   g++ -O2 -std=c++17 -I utils utils/*.cpp bench/priorityqueue.cpp
+// and pass grid sizes to override the default of 300 1000 3000.
+
+#include <grid.h>
+#include <priorityqueue.h>
+#include <range.h>
+#include <search.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+// cost of stepping into each cell, row-major
+std::vector<int> generateCosts(int size) {
+  std::vector<int> costs((size_t)size * size);
+  uint64_t state = 0x2545f4914f6cdd1dULL;
+  for (int &cost : costs) {
+    // xorshift; fixed seed so every run sees the same grid
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    cost = 1 + state % 9;
+  }
+  return costs;
+}
+
+// corner to corner with a hand-rolled std::priority_queue, the baseline
+long stdDijkstra(const std::vector<int> &costs, int size) {
+  using Entry = std::pair<long, int>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  std::vector<long> distances(costs.size(), std::numeric_limits<long>::max());
+
+  distances[0] = 0;
+  queue.push({0, 0});
+  while (!queue.empty()) {
+    auto [distance, index] = queue.top();
+    queue.pop();
+    if (distance > distances[index]) {
+      continue;
+    }
+
+    int x = index % size;
+    int y = index / size;
+    for (const auto &delta : ORTHOGONAL_DELTAS) {
+      int nextX = x + delta[0];
+      int nextY = y + delta[1];
+      if (nextX < 0 || nextX >= size || nextY < 0 || nextY >= size) {
+        continue;
+      }
+      int next = nextY * size + nextX;
+      long nextDistance = distance + costs[next];
+      if (nextDistance < distances[next]) {
+        distances[next] = nextDistance;
+        queue.push({nextDistance, next});
+      }
+    }
+  }
+
+  return distances.back();
+}
+
+template <template <typename> class Queue>
+long searchDijkstra(const std::vector<int> &costs, int size) {
+  Range<int> bounds{0, size - 1};
+  GraphSearch<Point2D, PointIndexer, Queue> search(
+      PointIndexer(bounds, bounds));
+  search.dijkstra({Point2D{0, 0}}, [&](const Point2D &point, auto &&emit) {
+    for (const auto &delta : ORTHOGONAL_DELTAS) {
+      Point2D next{point.x + delta[0], point.y + delta[1]};
+      if (bounds.contains(next.x) && bounds.contains(next.y)) {
+        emit(next, costs[(size_t)next.y * size + next.x]);
+      }
+    }
+  });
+  return search.distance({size - 1, size - 1});
+}
+
+template <typename Fn>
+void report(const std::string &label, Fn fn) {
+  auto start = std::chrono::high_resolution_clock::now();
+  long result = fn();
+  auto end = std::chrono::high_resolution_clock::now();
+
+  double ms = std::chrono::duration<double, std::milli>(end - start).count();
+  std::cout << "  " << std::left << std::setw(28) << label << ": "
+            << std::setw(10) << ms << "ms (" << result << ")" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  std::vector<int> sizes{300, 1000, 3000};
+  if (argc > 1) {
+    sizes.clear();
+    for (int i = 1; i < argc; i++) {
+      sizes.push_back(std::stoi(argv[i]));
+    }
+  }
+
+  for (int size : sizes) {
+    std::vector<int> costs = generateCosts(size);
+    std::cout << size << " x " << size << ":" << std::endl;
+    report("std::priority_queue", [&] { return stdDijkstra(costs, size); });
+    report("GraphSearch BinaryHeap",
+           [&] { return searchDijkstra<BinaryHeap>(costs, size); });
+    report("GraphSearch BucketQueue",
+           [&] { return searchDijkstra<BucketQueue>(costs, size); });
+    report("GraphSearch RadixHeap",
+           [&] { return searchDijkstra<RadixHeap>(costs, size); });
+  }
+
+  return 0;
+}
@@ -0,0 +1,195 @@
+#include <bitgrid.h>
+#include <grid.h>
+#include <range.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+BitGrid::BitGrid() {}
+
+BitGrid::BitGrid(Range<int> xBounds, Range<int> yBounds) {
+  this->xBounds = xBounds;
+  this->yBounds = yBounds;
+  this->width = xBounds.max - xBounds.min + 1;
+  this->height = yBounds.max - yBounds.min + 1;
+  this->wordsPerRow = (this->width + 63) / 64;
+  this->words.assign(this->wordsPerRow * this->height, 0);
+}
+
+uint64_t *BitGrid::row(int y) {
+  return this->words.data() + (y - this->yBounds.min) * this->wordsPerRow;
+}
+
+const uint64_t *BitGrid::row(int y) const {
+  return this->words.data() + (y - this->yBounds.min) * this->wordsPerRow;
+}
+
+void BitGrid::maskRow(int y) {
+  int extra = this->width % 64;
+  if (extra != 0) {
+    this->row(y)[this->wordsPerRow - 1] &= (uint64_t{1} << extra) - 1;
+  }
+}
+
+void BitGrid::requireSameBounds(const BitGrid &other,
+                                const char *where) const {
+  if (this->xBounds.min != other.xBounds.min ||
+      this->xBounds.max != other.xBounds.max ||
+      this->yBounds.min != other.yBounds.min ||
+      this->yBounds.max != other.yBounds.max) {
+    throw std::invalid_argument(std::string(where) +
+                                ": grids have different bounds");
+  }
+}
+
+bool BitGrid::operator[](const Point2D &point) const {
+  return this->get(point);
+}
+
+bool BitGrid::operator==(const BitGrid &other) const {
+  return this->xBounds.min == other.xBounds.min &&
+         this->xBounds.max == other.xBounds.max &&
+         this->yBounds.min == other.yBounds.min &&
+         this->yBounds.max == other.yBounds.max && this->words == other.words;
+}
+
+BitGrid &BitGrid::operator&=(const BitGrid &other) {
+  this->requireSameBounds(other, "BitGrid::operator&=");
+  for (size_t i = 0; i < this->words.size(); i++) {
+    this->words[i] &= other.words[i];
+  }
+  return *this;
+}
+
+BitGrid &BitGrid::operator|=(const BitGrid &other) {
+  this->requireSameBounds(other, "BitGrid::operator|=");
+  for (size_t i = 0; i < this->words.size(); i++) {
+    this->words[i] |= other.words[i];
+  }
+  return *this;
+}
+
+BitGrid &BitGrid::operator^=(const BitGrid &other) {
+  this->requireSameBounds(other, "BitGrid::operator^=");
+  for (size_t i = 0; i < this->words.size(); i++) {
+    this->words[i] ^= other.words[i];
+  }
+  return *this;
+}
+
+bool BitGrid::get(const Point2D &point) const {
+  int x = point.x - this->xBounds.min;
+  return (this->row(point.y)[x / 64] >> (x % 64)) & 1;
+}
+
+void BitGrid::set(const Point2D &point, bool value) {
+  int x = point.x - this->xBounds.min;
+  uint64_t bit = uint64_t{1} << (x % 64);
+  if (value) {
+    this->row(point.y)[x / 64] |= bit;
+  } else {
+    this->row(point.y)[x / 64] &= ~bit;
+  }
+}
+
+bool BitGrid::testAndSet(const Point2D &point) {
+  int x = point.x - this->xBounds.min;
+  uint64_t bit = uint64_t{1} << (x % 64);
+  uint64_t &word = this->row(point.y)[x / 64];
+  bool old = (word & bit) != 0;
+  word |= bit;
+  return old;
+}
+
+void BitGrid::clear() {
+  std::fill(this->words.begin(), this->words.end(), 0);
+}
+
+bool BitGrid::inBounds(const Point2D &point) const {
+  return this->xBounds.contains(point.x) && this->yBounds.contains(point.y);
+}
+
+size_t BitGrid::count() const {
+  size_t total = 0;
+  for (uint64_t word : this->words) {
+    total += __builtin_popcountll(word);
+  }
+  return total;
+}
+
+size_t BitGrid::countRow(int y) const {
+  const uint64_t *words = this->row(y);
+  size_t total = 0;
+  for (size_t i = 0; i < this->wordsPerRow; i++) {
+    total += __builtin_popcountll(words[i]);
+  }
+  return total;
+}
+
+void BitGrid::shiftRow(int y, int dx) {
+  uint64_t *words = this->row(y);
+  long n = this->wordsPerRow;
+  long wordShift = std::abs(dx) / 64;
+  int bitShift = std::abs(dx) % 64;
+
+  if (dx > 0) {
+    // bit i moves to i + dx, so fill from the high end down
+    for (long i = n - 1; i >= 0; i--) {
+      long src = i - wordShift;
+      uint64_t word = src >= 0 ? words[src] << bitShift : 0;
+      if (bitShift != 0 && src - 1 >= 0) {
+        word |= words[src - 1] >> (64 - bitShift);
+      }
+      words[i] = word;
+    }
+    this->maskRow(y);
+  } else if (dx < 0) {
+    for (long i = 0; i < n; i++) {
+      long src = i + wordShift;
+      uint64_t word = src < n ? words[src] >> bitShift : 0;
+      if (bitShift != 0 && src + 1 < n) {
+        word |= words[src + 1] << (64 - bitShift);
+      }
+      words[i] = word;
+    }
+  }
+}
+
+void BitGrid::andRow(int y, const BitGrid &other, int otherY) {
+  uint64_t *words = this->row(y);
+  const uint64_t *otherWords = other.row(otherY);
+  for (size_t i = 0; i < this->wordsPerRow; i++) {
+    words[i] &= otherWords[i];
+  }
+}
+
+void BitGrid::orRow(int y, const BitGrid &other, int otherY) {
+  uint64_t *words = this->row(y);
+  const uint64_t *otherWords = other.row(otherY);
+  for (size_t i = 0; i < this->wordsPerRow; i++) {
+    words[i] |= otherWords[i];
+  }
+}
+
+void BitGrid::xorRow(int y, const BitGrid &other, int otherY) {
+  uint64_t *words = this->row(y);
+  const uint64_t *otherWords = other.row(otherY);
+  for (size_t i = 0; i < this->wordsPerRow; i++) {
+    words[i] ^= otherWords[i];
+  }
+}
+
+void BitGrid::print() const {
+  for (int y = this->yBounds.min; y <= this->yBounds.max; y++) {
+    for (int x = this->xBounds.min; x <= this->xBounds.max; x++) {
+      std::cout << (this->get({x, y}) ? '#' : '.');
+    }
+    std::cout << std::endl;
+  }
+}
@@ -0,0 +1,64 @@
+#ifndef BITGRID_H
+#define BITGRID_H
+
+#include <grid.h>
+#include <range.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Fixed-size grid of booleans packed one bit per cell into 64-bit words. Each
+// row starts on a word boundary, so whole rows can be shifted, combined and
+// counted a word at a time.
+class BitGrid {
+ public:
+  Range<int> xBounds{0, 0};
+  Range<int> yBounds{0, 0};
+
+  BitGrid();
+  BitGrid(Range<int> xBounds, Range<int> yBounds);
+
+  bool operator[](const Point2D &point) const;
+  bool operator==(const BitGrid &other) const;
+  // combine cell by cell; throw std::invalid_argument unless other has the
+  // same bounds
+  BitGrid &operator&=(const BitGrid &other);
+  BitGrid &operator|=(const BitGrid &other);
+  BitGrid &operator^=(const BitGrid &other);
+
+  bool get(const Point2D &point) const;
+  void set(const Point2D &point, bool value = true);
+  // sets the bit and returns what it was before
+  bool testAndSet(const Point2D &point);
+  void clear();
+
+  bool inBounds(const Point2D &point) const;
+  size_t count() const;
+
+  // Row operations. Rows of other are matched up by index, so both grids
+  // need the same width
+  size_t countRow(int y) const;
+  // moves every bit in row y by dx (positive is towards larger x), dropping
+  // bits that fall off either end
+  void shiftRow(int y, int dx);
+  void andRow(int y, const BitGrid &other, int otherY);
+  void orRow(int y, const BitGrid &other, int otherY);
+  void xorRow(int y, const BitGrid &other, int otherY);
+
+  void print() const;
+
+ private:
+  int width = 0;
+  int height = 0;
+  size_t wordsPerRow = 0;
+  std::vector<uint64_t> words{};
+
+  uint64_t *row(int y);
+  const uint64_t *row(int y) const;
+  // zeroes the bits past the right edge of row y
+  void maskRow(int y);
+  void requireSameBounds(const BitGrid &other, const char *where) const;
+};
+
+#endif
@@ -0,0 +1,245 @@
+#include <bytescan.h>
+
+#include <cstring>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BYTESCAN_X86
+#endif
+
+namespace {
+
+// All kernels work on [begin, end) and return a pointer to the match, or end
+// (rbegin for the reverse search) when there isn't one.
+using FindByteFn = const char *(*)(const char *, const char *, char);
+using FindRangeFn = const char *(*)(const char *, const char *, char, char);
+
+bool inRange(char ch, unsigned char lo, unsigned char width) {
+  return static_cast<unsigned char>(ch - lo) <= width;
+}
+
+const char *findByteScalar(const char *begin, const char *end, char byte) {
+  for (const char *p = begin; p != end; p++) {
+    if (*p == byte) {
+      return p;
+    }
+  }
+  return end;
+}
+
+const char *findRangeScalar(const char *begin, const char *end, char lo,
+                            char hi) {
+  unsigned char width = hi - lo;
+  for (const char *p = begin; p != end; p++) {
+    if (inRange(*p, lo, width)) {
+      return p;
+    }
+  }
+  return end;
+}
+
+// returns end if not found
+const char *findRangeReverseScalar(const char *begin, const char *end, char lo,
+                                   char hi) {
+  unsigned char width = hi - lo;
+  for (const char *p = end; p != begin; p--) {
+    if (inRange(p[-1], lo, width)) {
+      return p - 1;
+    }
+  }
+  return end;
+}
+
+#ifdef BYTESCAN_X86
+
+// x - lo <= width, unsigned, is the same as max(x - lo, width) == width
+__m128i rangeMask128(__m128i chunk, __m128i lo, __m128i width) {
+  __m128i shifted = _mm_sub_epi8(chunk, lo);
+  return _mm_cmpeq_epi8(_mm_max_epu8(shifted, width), width);
+}
+
+const char *findByteSse2(const char *begin, const char *end, char byte) {
+  __m128i needle = _mm_set1_epi8(byte);
+  const char *p = begin;
+  for (; end - p >= 16; p += 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+    if (mask != 0) {
+      return p + __builtin_ctz(mask);
+    }
+  }
+  return findByteScalar(p, end, byte);
+}
+
+const char *findRangeSse2(const char *begin, const char *end, char lo,
+                          char hi) {
+  __m128i loVec = _mm_set1_epi8(lo);
+  __m128i widthVec = _mm_set1_epi8(static_cast<char>(hi - lo));
+  const char *p = begin;
+  for (; end - p >= 16; p += 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    int mask = _mm_movemask_epi8(rangeMask128(chunk, loVec, widthVec));
+    if (mask != 0) {
+      return p + __builtin_ctz(mask);
+    }
+  }
+  return findRangeScalar(p, end, lo, hi);
+}
+
+const char *findRangeReverseSse2(const char *begin, const char *end, char lo,
+                                 char hi) {
+  __m128i loVec = _mm_set1_epi8(lo);
+  __m128i widthVec = _mm_set1_epi8(static_cast<char>(hi - lo));
+  const char *p = end;
+  for (; p - begin >= 16; p -= 16) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p - 16));
+    int mask = _mm_movemask_epi8(rangeMask128(chunk, loVec, widthVec));
+    if (mask != 0) {
+      return p - 16 + (31 - __builtin_clz(mask));
+    }
+  }
+  const char *found = findRangeReverseScalar(begin, p, lo, hi);
+  return found == p ? end : found;
+}
+
+__attribute__((target("avx2"))) const char *findByteAvx2(const char *begin,
+                                                         const char *end,
+                                                         char byte) {
+  __m256i needle = _mm256_set1_epi8(byte);
+  const char *p = begin;
+  for (; end - p >= 32; p += 32) {
+    __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    unsigned mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle));
+    if (mask != 0) {
+      return p + __builtin_ctz(mask);
+    }
+  }
+  return findByteSse2(p, end, byte);
+}
+
+__attribute__((target("avx2"))) const char *findRangeAvx2(const char *begin,
+                                                          const char *end,
+                                                          char lo, char hi) {
+  __m256i loVec = _mm256_set1_epi8(lo);
+  __m256i widthVec = _mm256_set1_epi8(static_cast<char>(hi - lo));
+  const char *p = begin;
+  for (; end - p >= 32; p += 32) {
+    __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    __m256i shifted = _mm256_sub_epi8(chunk, loVec);
+    __m256i hits =
+        _mm256_cmpeq_epi8(_mm256_max_epu8(shifted, widthVec), widthVec);
+    unsigned mask = _mm256_movemask_epi8(hits);
+    if (mask != 0) {
+      return p + __builtin_ctz(mask);
+    }
+  }
+  return findRangeSse2(p, end, lo, hi);
+}
+
+__attribute__((target("avx2"))) const char *findRangeReverseAvx2(
+    const char *begin, const char *end, char lo, char hi) {
+  __m256i loVec = _mm256_set1_epi8(lo);
+  __m256i widthVec = _mm256_set1_epi8(static_cast<char>(hi - lo));
+  const char *p = end;
+  for (; p - begin >= 32; p -= 32) {
+    __m256i chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p - 32));
+    __m256i shifted = _mm256_sub_epi8(chunk, loVec);
+    __m256i hits =
+        _mm256_cmpeq_epi8(_mm256_max_epu8(shifted, widthVec), widthVec);
+    unsigned mask = _mm256_movemask_epi8(hits);
+    if (mask != 0) {
+      return p - 32 + (31 - __builtin_clz(mask));
+    }
+  }
+  const char *found = findRangeReverseSse2(begin, p, lo, hi);
+  return found == p ? end : found;
+}
+
+#endif
+
+struct Kernels {
+  const char *level;
+  FindByteFn findByte;
+  FindRangeFn findRange;
+  FindRangeFn findRangeReverse;
+};
+
+Kernels pickKernels() {
+#ifdef BYTESCAN_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return {"avx2", findByteAvx2, findRangeAvx2, findRangeReverseAvx2};
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return {"sse2", findByteSse2, findRangeSse2, findRangeReverseSse2};
+  }
+#endif
+  return {"scalar", findByteScalar, findRangeScalar, findRangeReverseScalar};
+}
+
+const Kernels &kernels() {
+  static const Kernels picked = pickKernels();
+  return picked;
+}
+
+size_t toPosition(std::string_view str, const char *found) {
+  const char *end = str.data() + str.size();
+  return found == end ? std::string_view::npos : found - str.data();
+}
+
+}  // namespace
+
+size_t scanForByte(std::string_view str, char byte, size_t from) {
+  if (from >= str.size()) {
+    return std::string_view::npos;
+  }
+  const char *end = str.data() + str.size();
+  return toPosition(str, kernels().findByte(str.data() + from, end, byte));
+}
+
+size_t scanFor(std::string_view str, std::string_view needle, size_t from) {
+  if (needle.empty()) {
+    return from <= str.size() ? from : std::string_view::npos;
+  }
+
+  // find candidates by their first byte, then confirm the rest
+  size_t pos = from;
+  while ((pos = scanForByte(str, needle[0], pos)) != std::string_view::npos) {
+    if (str.size() - pos < needle.size()) {
+      return std::string_view::npos;
+    }
+    if (std::memcmp(str.data() + pos + 1, needle.data() + 1,
+                    needle.size() - 1) == 0) {
+      return pos;
+    }
+    pos++;
+  }
+  return std::string_view::npos;
+}
+
+size_t scanForRange(std::string_view str, char lo, char hi, size_t from) {
+  if (from >= str.size()) {
+    return std::string_view::npos;
+  }
+  const char *end = str.data() + str.size();
+  return toPosition(str, kernels().findRange(str.data() + from, end, lo, hi));
+}
+
+size_t scanForRangeReverse(std::string_view str, char lo, char hi) {
+  const char *end = str.data() + str.size();
+  return toPosition(str,
+                    kernels().findRangeReverse(str.data(), end, lo, hi));
+}
+
+size_t scanForDigit(std::string_view str, size_t from) {
+  return scanForRange(str, '0', '9', from);
+}
+
+size_t scanForLastDigit(std::string_view str) {
+  return scanForRangeReverse(str, '0', '9');
+}
+
+const char *byteScanLevel() { return kernels().level; }
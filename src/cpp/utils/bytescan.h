@@ -0,0 +1,27 @@
+#ifndef BYTESCAN_H
+#define BYTESCAN_H
+
+#include <string_view>
+
+// Vectorized byte searches. Each one returns a position like std::string::find
+// does (std::string_view::npos when nothing matches). On x86 the AVX2 or SSE2
+// kernel is picked once at startup based on what the CPU supports; everywhere
+// else a plain loop is used.
+
+// first occurrence of byte at or after from
+size_t scanForByte(std::string_view str, char byte, size_t from = 0);
+
+// first occurrence of needle at or after from
+size_t scanFor(std::string_view str, std::string_view needle, size_t from = 0);
+
+// first / last byte in the inclusive range [lo, hi] (compared unsigned)
+size_t scanForRange(std::string_view str, char lo, char hi, size_t from = 0);
+size_t scanForRangeReverse(std::string_view str, char lo, char hi);
+
+size_t scanForDigit(std::string_view str, size_t from = 0);
+size_t scanForLastDigit(std::string_view str);
+
+// "avx2", "sse2" or "scalar"; whichever kernel set is in use
+const char *byteScanLevel();
+
+#endif
@@ -0,0 +1,220 @@
+#include <chargridview.h>
+#include <densegrid.h>
+#include <file.h>
+#include <grid.h>
+#include <range.h>
+
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+CharGridView::iterator::reference CharGridView::iterator::operator*() const {
+  Point2D point = this->grid->pointAt(this->pos);
+  return {point, (*this->grid)[point]};
+}
+
+CharGridView::iterator &CharGridView::iterator::operator++() {
+  this->pos += this->step;
+  return *this;
+}
+
+CharGridView::iterator CharGridView::iterator::operator++(int) {
+  iterator old = *this;
+  this->pos += this->step;
+  return old;
+}
+
+bool CharGridView::iterator::operator==(const iterator &other) const {
+  return this->grid == other.grid && this->pos == other.pos;
+}
+
+bool CharGridView::iterator::operator!=(const iterator &other) const {
+  return !(*this == other);
+}
+
+CharGridView::CharGridView() {}
+
+CharGridView::CharGridView(std::string_view buffer, bool excludeDiagonals) {
+  this->excludeDiagonals = excludeDiagonals;
+  if (!buffer.empty() && buffer.back() == '\n') {
+    buffer.remove_suffix(1);
+  }
+  if (buffer.empty()) {
+    return;
+  }
+
+  size_t width = buffer.find('\n');
+  if (width == std::string_view::npos) {
+    width = buffer.size();
+  }
+  // with its last newline dropped, the buffer is height * stride - 1 bytes
+  size_t stride = width + 1;
+  if (width == 0 || (buffer.size() + 1) % stride != 0) {
+    throw std::runtime_error("CharGridView: rows aren't all the same width");
+  }
+  size_t height = (buffer.size() + 1) / stride;
+  for (size_t y = 1; y < height; y++) {
+    if (buffer[y * stride - 1] != '\n') {
+      throw std::runtime_error("CharGridView: rows aren't all the same width");
+    }
+  }
+
+  this->data = buffer.data();
+  this->width = width;
+  this->height = height;
+  this->stride = stride;
+  this->xBounds = {0, (int)width - 1};
+  this->yBounds = {0, (int)height - 1};
+}
+
+CharGridView::CharGridView(const MappedInput &input, bool excludeDiagonals)
+    : CharGridView(input.view(), excludeDiagonals) {}
+
+Point2D CharGridView::pointAt(long pos) const {
+  return Point2D(pos % this->width, pos / this->width);
+}
+
+const char &CharGridView::operator[](const Point2D &point) const {
+  return this->data[point.y * this->stride + point.x];
+}
+
+bool CharGridView::operator==(const CharGridView &other) const {
+  if (this->width != other.width || this->height != other.height) {
+    return false;
+  }
+  for (int y = 0; y < this->height; y++) {
+    if (this->line(y) != other.line(y)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const char &CharGridView::at(const Point2D &point) const {
+  if (!this->inBounds(point)) {
+    throwOutOfRange("CharGridView::at", point);
+  }
+  return (*this)[point];
+}
+
+CharGridView::iterator CharGridView::find(const Point2D &point) const {
+  if (!this->inBounds(point)) {
+    return this->end();
+  }
+  return iterator(this, (long)point.y * this->width + point.x, 1);
+}
+
+CharGridView::iterator CharGridView::begin() const {
+  return iterator(this, 0, 1);
+}
+
+CharGridView::iterator CharGridView::rbegin() const {
+  return iterator(this, (long)this->size() - 1, -1);
+}
+
+CharGridView::iterator CharGridView::end() const {
+  return iterator(this, this->size(), 1);
+}
+
+CharGridView::iterator CharGridView::rend() const {
+  return iterator(this, -1, -1);
+}
+
+size_t CharGridView::size() const {
+  return (size_t)this->width * this->height;
+}
+
+bool CharGridView::inBounds(const Point2D &point) const {
+  return this->size() != 0 && this->xBounds.contains(point.x) &&
+         this->yBounds.contains(point.y);
+}
+
+const char *CharGridView::lookup(const Point2D &point) const {
+  if (!this->inBounds(point)) {
+    return nullptr;
+  }
+  return &(*this)[point];
+}
+
+NeighborRange<CharGridView, char> CharGridView::neighbors(
+    const Point2D &point) const {
+  return this->neighbors(point, this->excludeDiagonals);
+}
+
+NeighborRange<CharGridView, char> CharGridView::neighbors(
+    const Point2D &point, bool excludeDiagonals) const {
+  return NeighborRange<CharGridView, char>(*this, point, excludeDiagonals);
+}
+
+NeighborRange<CharGridView, char, false> CharGridView::interiorNeighbors(
+    const Point2D &point) const {
+  return NeighborRange<CharGridView, char, false>(*this, point,
+                                                  this->excludeDiagonals);
+}
+
+std::map<Point2D, char> CharGridView::pointsAdjacent(
+    const Point2D &point) const {
+  std::map<Point2D, char> adjacent{};
+  for (const auto &pair : this->neighbors(point)) {
+    adjacent[pair.first] = pair.second;
+  }
+  return adjacent;
+}
+
+DenseGrid2D<char> CharGridView::subRegion(Range<int> xBounds,
+                                          Range<int> yBounds) const {
+  DenseGrid2D<char> newGrid(xBounds, yBounds);
+  newGrid.excludeDiagonals = this->excludeDiagonals;
+
+  for (int y = yBounds.min; y <= yBounds.max; y++) {
+    for (int x = xBounds.min; x <= xBounds.max; x++) {
+      newGrid[{x, y}] = this->at({x, y});
+    }
+  }
+
+  return newGrid;
+}
+
+std::vector<char> CharGridView::row(int y) const {
+  std::string_view line = this->line(y);
+  return std::vector<char>(line.begin(), line.end());
+}
+
+std::vector<char> CharGridView::col(int x) const {
+  std::vector<char> vec{};
+  vec.reserve(this->height);
+  for (int y = 0; y < this->height; y++) {
+    vec.push_back((*this)[{x, y}]);
+  }
+  return vec;
+}
+
+std::string_view CharGridView::line(int y) const {
+  return std::string_view(this->data + y * this->stride, this->width);
+}
+
+LineView<CharGridView, char> CharGridView::rowView(int y) const {
+  return this->regionView(this->xBounds, this->yBounds).row(y);
+}
+
+LineView<CharGridView, char> CharGridView::colView(int x) const {
+  return this->regionView(this->xBounds, this->yBounds).col(x);
+}
+
+RegionView<CharGridView, char> CharGridView::regionView(
+    Range<int> xBounds, Range<int> yBounds) const {
+  return RegionView<CharGridView, char>(*this, xBounds, yBounds);
+}
+
+RegionView<CharGridView, char> CharGridView::transposed() const {
+  return this->regionView(this->xBounds, this->yBounds).transposed();
+}
+
+void CharGridView::print() const {
+  for (int y = 0; y < this->height; y++) {
+    std::cout << this->line(y) << std::endl;
+  }
+}
@@ -0,0 +1,109 @@
+#ifndef CHARGRIDVIEW_H
+#define CHARGRIDVIEW_H
+
+#include <densegrid.h>
+#include <file.h>
+#include <grid.h>
+#include <range.h>
+
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Read-only Grid2D<char> that reads straight out of a text buffer, usually a
+// MappedInput, instead of copying it. The top left cell is (0, 0) and row y
+// starts y * (width + 1) bytes in, so the newlines are just skipped over.
+// Building one only checks where the rows end; the buffer has to outlive the
+// view.
+class CharGridView {
+ public:
+  class iterator {
+   public:
+    using value_type = std::pair<Point2D, const char &>;
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    struct pointer {
+      value_type pair;
+      const value_type *operator->() const { return &this->pair; }
+    };
+
+    iterator(const CharGridView *grid, long pos, int step)
+        : grid(grid), pos(pos), step(step) {}
+
+    reference operator*() const;
+    pointer operator->() const { return pointer{**this}; }
+    iterator &operator++();
+    iterator operator++(int);
+    bool operator==(const iterator &other) const;
+    bool operator!=(const iterator &other) const;
+
+   private:
+    const CharGridView *grid;
+    long pos;
+    int step;
+  };
+
+  bool excludeDiagonals = false;
+  Range<int> xBounds{0, 0};
+  Range<int> yBounds{0, 0};
+
+  CharGridView();
+  // Every line of buffer is a row, and they all have to be as long as the
+  // first one; throws std::runtime_error if they aren't. A single trailing
+  // newline is fine.
+  CharGridView(std::string_view buffer, bool excludeDiagonals = false);
+  CharGridView(const MappedInput &input, bool excludeDiagonals = false);
+
+  // no bounds checking; use at() for a checked read
+  const char &operator[](const Point2D &point) const;
+  bool operator==(const CharGridView &other) const;
+
+  const char &at(const Point2D &point) const;
+  iterator find(const Point2D &point) const;
+  iterator begin() const;
+  iterator rbegin() const;
+  iterator end() const;
+  iterator rend() const;
+  size_t size() const;
+
+  bool inBounds(const Point2D &point) const;
+  // the cell at point, or nullptr if it's out of bounds
+  const char *lookup(const Point2D &point) const;
+  // neighbors of point, diagonals included unless excludeDiagonals is set
+  NeighborRange<CharGridView, char> neighbors(const Point2D &point) const;
+  NeighborRange<CharGridView, char> neighbors(const Point2D &point,
+                                              bool excludeDiagonals) const;
+  // same as neighbors() without bounds checks; point can't be on the border
+  NeighborRange<CharGridView, char, false> interiorNeighbors(
+      const Point2D &point) const;
+  std::map<Point2D, char> pointsAdjacent(const Point2D &point) const;
+  // an owning copy, since a view can't be written to
+  DenseGrid2D<char> subRegion(Range<int> xBounds, Range<int> yBounds) const;
+  std::vector<char> row(int y) const;
+  std::vector<char> col(int x) const;
+  // row y as it sits in the buffer, without copying
+  std::string_view line(int y) const;
+  // non-owning versions of the above; see LineView and RegionView
+  LineView<CharGridView, char> rowView(int y) const;
+  LineView<CharGridView, char> colView(int x) const;
+  RegionView<CharGridView, char> regionView(Range<int> xBounds,
+                                            Range<int> yBounds) const;
+  RegionView<CharGridView, char> transposed() const;
+  void print() const;
+
+ private:
+  const char *data = nullptr;
+  int width = 0;
+  int height = 0;
+  // width + 1, for the newline
+  size_t stride = 0;
+
+  Point2D pointAt(long pos) const;
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include <components.h>
+#include <grid.h>
+#include <unionfind.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+ComponentLabels::ComponentLabels() {}
+
+int ComponentLabels::stripHeight(int threads) const {
+  threads = std::clamp(threads, 1, std::max(this->height, 1));
+  return std::max((this->height + threads - 1) / threads, 1);
+}
+
+void ComponentLabels::forEachStrip(
+    int threads, const std::function<void(int, int)> &fn) const {
+  int stripHeight = this->stripHeight(threads);
+  if (stripHeight >= this->height) {
+    fn(0, this->height - 1);
+    return;
+  }
+
+  std::vector<std::thread> workers;
+  for (int firstY = 0; firstY < this->height; firstY += stripHeight) {
+    int lastY = std::min(firstY + stripHeight, this->height) - 1;
+    workers.emplace_back(fn, firstY, lastY);
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+}
+
+void ComponentLabels::labelCells(const std::vector<uint8_t> &included,
+                                 bool excludeDiagonals, int threads) {
+  int width = this->width;
+  DisjointSets sets(included.size());
+
+  // unites the cell with whichever of its neighbors in row y - 1 are included
+  auto uniteAbove = [&](int x, int y) {
+    size_t index = (size_t)y * width + x;
+    size_t above = index - width;
+    if (included[above]) {
+      sets.unite(index, above);
+    }
+    if (!excludeDiagonals) {
+      if (x > 0 && included[above - 1]) {
+        sets.unite(index, above - 1);
+      }
+      if (x + 1 < width && included[above + 1]) {
+        sets.unite(index, above + 1);
+      }
+    }
+  };
+
+  // first pass: every strip only unites cells inside itself, so the strips'
+  // sets never overlap and they can share one DisjointSets
+  this->forEachStrip(threads, [&](int firstY, int lastY) {
+    for (int y = firstY; y <= lastY; y++) {
+      for (int x = 0; x < width; x++) {
+        size_t index = (size_t)y * width + x;
+        if (!included[index]) {
+          continue;
+        }
+        if (x > 0 && included[index - 1]) {
+          sets.unite(index, index - 1);
+        }
+        if (y > firstY) {
+          uniteAbove(x, y);
+        }
+      }
+    }
+  });
+
+  // stitch each strip to the one above it
+  int stripHeight = this->stripHeight(threads);
+  for (int y = stripHeight; y < this->height; y += stripHeight) {
+    for (int x = 0; x < width; x++) {
+      if (included[(size_t)y * width + x]) {
+        uniteAbove(x, y);
+      }
+    }
+  }
+
+  // second pass: a set's root is its first cell row-major, so it always gets
+  // its label before any other cell in the set asks for it
+  this->labels.assign(included.size(), NONE);
+  this->sizes.clear();
+  this->borders.clear();
+  for (int y = 0; y < this->height; y++) {
+    for (int x = 0; x < width; x++) {
+      size_t index = (size_t)y * width + x;
+      if (!included[index]) {
+        continue;
+      }
+
+      size_t root = sets.find(index);
+      int label;
+      if (root == index) {
+        label = this->sizes.size();
+        this->sizes.push_back(0);
+        this->borders.push_back(false);
+      } else {
+        label = this->labels[root];
+      }
+      this->labels[index] = label;
+      this->sizes[label]++;
+      if (x == 0 || y == 0 || x == width - 1 || y == this->height - 1) {
+        this->borders[label] = true;
+      }
+    }
+  }
+}
+
+int ComponentLabels::label(const Point2D &point) const {
+  if (!this->xBounds.contains(point.x) || !this->yBounds.contains(point.y)) {
+    return NONE;
+  }
+  return this->labels[(size_t)(point.y - this->yBounds.min) * this->width +
+                      (point.x - this->xBounds.min)];
+}
+
+int ComponentLabels::count() const { return this->sizes.size(); }
+
+size_t ComponentLabels::size(int label) const { return this->sizes.at(label); }
+
+bool ComponentLabels::touchesBorder(int label) const {
+  return this->borders.at(label);
+}
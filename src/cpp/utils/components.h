@@ -0,0 +1,68 @@
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include <grid.h>
+#include <range.h>
+#include <unionfind.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Connected components of the cells of a grid that pass some test, found with
+// the classic two-pass labeling: a raster scan unites every included cell with
+// its included neighbors above and to the left in a flat DisjointSets, then a
+// second scan numbers the sets. Components are numbered from 0 in the order
+// their first cell comes up row-major, and their sizes and whether they touch
+// the edge of the grid come out of the same pass.
+//
+// With threads > 1 the rows are split into strips that are scanned in
+// parallel and then stitched together along the strip boundaries. Labels come
+// out the same either way.
+class ComponentLabels {
+ public:
+  static constexpr int NONE = -1;
+
+  Range<int> xBounds{0, 0};
+  Range<int> yBounds{0, 0};
+
+  ComponentLabels();
+  // Labels the cells include(value) accepts, treating diagonal neighbors as
+  // connected unless grid.excludeDiagonals is set. Cells a sparse grid doesn't
+  // have are never included
+  template <typename Grid, typename IncludeFn>
+  ComponentLabels(const Grid &grid, IncludeFn include);
+  template <typename Grid, typename IncludeFn>
+  ComponentLabels(const Grid &grid, IncludeFn include, bool excludeDiagonals,
+                  int threads = 1);
+
+  // component of the cell at point, or NONE if it wasn't included
+  int label(const Point2D &point) const;
+  int count() const;
+  size_t size(int label) const;
+  // whether any cell of the component is on the edge of the grid's bounds
+  bool touchesBorder(int label) const;
+
+ private:
+  int width = 0;
+  int height = 0;
+  // one per cell, row-major
+  std::vector<int> labels{};
+  std::vector<size_t> sizes{};
+  std::vector<uint8_t> borders{};
+
+  // rows per strip when splitting the grid between threads
+  int stripHeight(int threads) const;
+  // calls fn(firstY, lastY) for each strip of rows, one thread per strip,
+  // with rows counted from 0
+  void forEachStrip(int threads,
+                    const std::function<void(int, int)> &fn) const;
+  // the two passes, over included (one flag per cell, row-major)
+  void labelCells(const std::vector<uint8_t> &included, bool excludeDiagonals,
+                  int threads);
+};
+
+#include "components.tpp"
+
+#endif
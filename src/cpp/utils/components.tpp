@@ -0,0 +1,36 @@
+#ifndef COMPONENTS_TPP
+#define COMPONENTS_TPP
+
+#include <grid.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "components.h"
+
+template <typename Grid, typename IncludeFn>
+ComponentLabels::ComponentLabels(const Grid &grid, IncludeFn include)
+    : ComponentLabels(grid, include, grid.excludeDiagonals) {}
+
+template <typename Grid, typename IncludeFn>
+ComponentLabels::ComponentLabels(const Grid &grid, IncludeFn include,
+                                 bool excludeDiagonals, int threads)
+    : xBounds(grid.xBounds),
+      yBounds(grid.yBounds),
+      width(grid.xBounds.max - grid.xBounds.min + 1),
+      height(grid.yBounds.max - grid.yBounds.min + 1) {
+  std::vector<uint8_t> included((size_t)this->width * this->height);
+  this->forEachStrip(threads, [&](int firstY, int lastY) {
+    for (int y = firstY; y <= lastY; y++) {
+      for (int x = 0; x < this->width; x++) {
+        const auto *cell = grid.lookup(
+            Point2D{this->xBounds.min + x, this->yBounds.min + y});
+        included[(size_t)y * this->width + x] =
+            cell != nullptr && include(*cell);
+      }
+    }
+  });
+  this->labelCells(included, excludeDiagonals, threads);
+}
+
+#endif
@@ -0,0 +1,177 @@
+#ifndef DENSEGRID_H
+#define DENSEGRID_H
+
+#include <grid.h>
+#include <gridlayout.h>
+#include <range.h>
+#include <zobrist.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Grid2D with its cells stored contiguously in row-major order, so every access
+// is index arithmetic instead of a map lookup. Every point inside the bounds is
+// a cell (default-constructed until written). Writing outside the bounds
+// through operator[] grows the grid just like Grid2D; the storage grows
+// geometrically, so filling a grid one cell at a time stays cheap.
+//
+// Layout decides how cells are ordered in memory (see gridlayout.h). It's
+// invisible to callers; TiledLayout or MortonLayout keep column walks
+// cache-local on big grids at the cost of some padding. Access decides whether
+// the const operator[] checks its point; see CheckedAccess in grid.h.
+template <typename T, typename Layout = RowMajorLayout,
+          typename Access = DefaultAccess>
+class DenseGrid2D {
+  static_assert(!std::is_same_v<T, bool>,
+                "std::vector<bool> can't hand out T&; use BitGrid instead");
+
+ public:
+  // Iterates cells in row-major order (backwards from rbegin()), yielding
+  // (point, value) pairs the same way iterating a Grid2D does
+  class iterator {
+   public:
+    using value_type = std::pair<Point2D, const T &>;
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    struct pointer {
+      value_type pair;
+      const value_type *operator->() const { return &this->pair; }
+    };
+
+    iterator(const DenseGrid2D<T, Layout, Access> *grid, long pos, int step)
+        : grid(grid), pos(pos), step(step) {}
+
+    reference operator*() const;
+    pointer operator->() const { return pointer{**this}; }
+    iterator &operator++();
+    iterator operator++(int);
+    bool operator==(const iterator &other) const;
+    bool operator!=(const iterator &other) const;
+
+   private:
+    const DenseGrid2D<T, Layout, Access> *grid;
+    long pos;
+    int step;
+  };
+
+  bool excludeDiagonals = false;
+  Range<int> xBounds{0, 0};
+  Range<int> yBounds{0, 0};
+
+  DenseGrid2D();
+  DenseGrid2D(bool excludeDiagonals);
+  // every cell in the bounds starts out as fill
+  DenseGrid2D(Range<int> xBounds, Range<int> yBounds, const T &fill = T{});
+  // same, with a border of sentinel cells around the bounds; see pad()
+  DenseGrid2D(Range<int> xBounds, Range<int> yBounds, const T &fill,
+              const T &sentinel, int border = 1);
+  DenseGrid2D(const DenseGrid2D<T, Layout, Access> &other) = default;
+  DenseGrid2D(DenseGrid2D<T, Layout, Access> &&other) = default;
+
+  DenseGrid2D<T, Layout, Access> &operator=(
+      const DenseGrid2D<T, Layout, Access> &other) = default;
+  DenseGrid2D<T, Layout, Access> &operator=(
+      DenseGrid2D<T, Layout, Access> &&other) = default;
+
+  T &operator[](const Point2D &point);
+  // never grows; only checks that point is in the bounds or the pad() border
+  // if Access says to. Use at() for a bounds-checked read
+  const T &operator[](const Point2D &point) const;
+  bool operator==(const DenseGrid2D<T, Layout, Access> &other) const;
+
+  const T &at(const Point2D &point) const;
+  iterator find(const Point2D &point) const;
+  iterator begin() const;
+  iterator rbegin() const;
+  iterator end() const;
+  iterator rend() const;
+  size_t size() const;
+
+  bool inBounds(const Point2D &point) const;
+  // the cell at point, or nullptr if it's out of bounds
+  const T *lookup(const Point2D &point) const;
+  // neighbors of point, diagonals included unless excludeDiagonals is set
+  NeighborRange<DenseGrid2D<T, Layout, Access>, T> neighbors(
+      const Point2D &point) const;
+  NeighborRange<DenseGrid2D<T, Layout, Access>, T> neighbors(
+      const Point2D &point, bool excludeDiagonals) const;
+  // same as neighbors() without bounds checks; point can't be on the edge
+  // unless the grid is padded
+  NeighborRange<DenseGrid2D<T, Layout, Access>, T, false> interiorNeighbors(
+      const Point2D &point) const;
+  std::map<Point2D, T> pointsAdjacent(const Point2D &point) const;
+  DenseGrid2D<T, Layout, Access> subRegion(Range<int> xBounds,
+                                           Range<int> yBounds) const;
+  std::vector<T> row(int y) const;
+  std::vector<T> col(int x) const;
+  // non-owning versions of the above; see LineView and RegionView
+  LineView<DenseGrid2D<T, Layout, Access>, T> rowView(int y) const;
+  LineView<DenseGrid2D<T, Layout, Access>, T> colView(int x) const;
+  RegionView<DenseGrid2D<T, Layout, Access>, T> regionView(
+      Range<int> xBounds, Range<int> yBounds) const;
+  RegionView<DenseGrid2D<T, Layout, Access>, T> transposed() const;
+  void print() const;
+
+  // Surrounds the bounds with border rings of sentinel cells. They live in
+  // storage but outside the bounds, so iteration, size(), inBounds(), at() and
+  // lookup() don't see them, but the const operator[] (checked or not) and
+  // interiorNeighbors() do: a walk can run until it hits the sentinel instead
+  // of checking the bounds every step. Points keep their coordinates. Writing
+  // outside the bounds through operator[] still grows the grid, but drops the
+  // padding first: every cell it brings into the bounds is T{}, the same as an
+  // unpadded grid, and there's no border left to read.
+  void pad(const T &sentinel, int border = 1);
+
+  // Starts keeping a Zobrist hash of every cell in the bounds, updated in O(1)
+  // per write. Pass wide for 128 bits instead of 64
+  void enableHashing(bool wide = false);
+  // throws if hashing isn't enabled
+  GridHash hash() const;
+  // O(1); swaps everything, bounds and hashing state included
+  void swap(DenseGrid2D<T, Layout, Access> &other);
+
+ private:
+  // copies snapshotted cells straight into storage
+  friend class SnapshotReader;
+
+  // Storage covers [xOrigin, xOrigin + width) x [yOrigin, yOrigin + height),
+  // which can be larger than the bounds once the grid has grown
+  int xOrigin = 0;
+  int yOrigin = 0;
+  int width = 0;
+  int height = 0;
+  // rings of sentinel cells from pad(), or 0
+  int border = 0;
+  Layout layout{};
+  std::vector<T> cells{};
+
+  // operator[] can't see what gets written through the reference it returns,
+  // so when hashing it toggles the cell's old value out of the hash right away
+  // and leaves it pending; hash() toggles the current values back in
+  mutable std::optional<ZobristHash> zobrist{};
+  mutable std::vector<Point2D> pendingPoints{};
+  mutable std::vector<uint8_t> pendingCells{};
+
+  size_t index(int x, int y) const;
+  Point2D pointAt(long pos) const;
+  void grow(const Point2D &point);
+  void unpad();
+  void growHashed(const Point2D &point);
+  void flushHash() const;
+};
+
+template <typename T, typename Layout, typename Access>
+void swap(DenseGrid2D<T, Layout, Access> &a,
+          DenseGrid2D<T, Layout, Access> &b);
+
+#include "densegrid.tpp"
+
+#endif
@@ -0,0 +1,525 @@
+#ifndef DENSEGRID_TPP
+#define DENSEGRID_TPP
+
+#include <grid.h>
+#include <gridlayout.h>
+#include <range.h>
+#include <zobrist.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "densegrid.h"
+
+template <typename T, typename Layout, typename Access>
+typename DenseGrid2D<T, Layout, Access>::iterator::reference
+DenseGrid2D<T, Layout, Access>::iterator::operator*() const {
+  Point2D point = this->grid->pointAt(this->pos);
+  return {point, (*this->grid)[point]};
+}
+
+template <typename T, typename Layout, typename Access>
+typename DenseGrid2D<T, Layout, Access>::iterator &
+DenseGrid2D<T, Layout, Access>::iterator::operator++() {
+  this->pos += this->step;
+  return *this;
+}
+
+template <typename T, typename Layout, typename Access>
+typename DenseGrid2D<T, Layout, Access>::iterator
+DenseGrid2D<T, Layout, Access>::iterator::operator++(int) {
+  iterator old = *this;
+  this->pos += this->step;
+  return old;
+}
+
+template <typename T, typename Layout, typename Access>
+bool DenseGrid2D<T, Layout, Access>::iterator::operator==(
+    const iterator &other) const {
+  return this->grid == other.grid && this->pos == other.pos;
+}
+
+template <typename T, typename Layout, typename Access>
+bool DenseGrid2D<T, Layout, Access>::iterator::operator!=(
+    const iterator &other) const {
+  return !(*this == other);
+}
+
+template <typename T, typename Layout, typename Access>
+DenseGrid2D<T, Layout, Access>::DenseGrid2D() {}
+
+template <typename T, typename Layout, typename Access>
+DenseGrid2D<T, Layout, Access>::DenseGrid2D(bool excludeDiagonals) {
+  this->excludeDiagonals = excludeDiagonals;
+}
+
+template <typename T, typename Layout, typename Access>
+DenseGrid2D<T, Layout, Access>::DenseGrid2D(Range<int> xBounds,
+                                            Range<int> yBounds, const T &fill) {
+  this->xBounds = xBounds;
+  this->yBounds = yBounds;
+  this->xOrigin = xBounds.min;
+  this->yOrigin = yBounds.min;
+  this->width = xBounds.max - xBounds.min + 1;
+  this->height = yBounds.max - yBounds.min + 1;
+  this->layout = Layout(this->width, this->height);
+  this->cells.assign(this->layout.size(), fill);
+}
+
+template <typename T, typename Layout, typename Access>
+DenseGrid2D<T, Layout, Access>::DenseGrid2D(Range<int> xBounds,
+                                            Range<int> yBounds, const T &fill,
+                                            const T &sentinel, int border)
+    : DenseGrid2D(xBounds, yBounds, fill) {
+  this->pad(sentinel, border);
+}
+
+template <typename T, typename Layout, typename Access>
+size_t DenseGrid2D<T, Layout, Access>::index(int x, int y) const {
+  return this->layout.index(x - this->xOrigin, y - this->yOrigin);
+}
+
+template <typename T, typename Layout, typename Access>
+Point2D DenseGrid2D<T, Layout, Access>::pointAt(long pos) const {
+  int boundsWidth = this->xBounds.max - this->xBounds.min + 1;
+  return Point2D(this->xBounds.min + pos % boundsWidth,
+                 this->yBounds.min + pos / boundsWidth);
+}
+
+template <typename T, typename Layout, typename Access>
+void DenseGrid2D<T, Layout, Access>::grow(const Point2D &point) {
+  if (this->cells.empty()) {
+    // first cell
+    this->xBounds = {point.x, point.x};
+    this->yBounds = {point.y, point.y};
+    this->xOrigin = point.x;
+    this->yOrigin = point.y;
+    this->width = 1;
+    this->height = 1;
+    this->layout = Layout(1, 1);
+    this->cells.assign(this->layout.size(), T{});
+    return;
+  }
+  if (this->border > 0) {
+    // otherwise border cells would come into the bounds still holding the
+    // sentinel
+    this->unpad();
+  }
+
+  Range<int> newXBounds{std::min(this->xBounds.min, point.x),
+                        std::max(this->xBounds.max, point.x)};
+  Range<int> newYBounds{std::min(this->yBounds.min, point.y),
+                        std::max(this->yBounds.max, point.y)};
+
+  // if it's still inside the storage we just need to widen the bounds
+  int xMin = this->xOrigin;
+  int xMax = this->xOrigin + this->width - 1;
+  int yMin = this->yOrigin;
+  int yMax = this->yOrigin + this->height - 1;
+  if (newXBounds.min >= xMin && newXBounds.max <= xMax &&
+      newYBounds.min >= yMin && newYBounds.max <= yMax) {
+    this->xBounds = newXBounds;
+    this->yBounds = newYBounds;
+    return;
+  }
+
+  // otherwise double the storage in whichever direction(s) it overflowed
+  if (point.x < xMin) xMin = point.x - this->width;
+  if (point.x > xMax) xMax = point.x + this->width;
+  if (point.y < yMin) yMin = point.y - this->height;
+  if (point.y > yMax) yMax = point.y + this->height;
+
+  int newWidth = xMax - xMin + 1;
+  int newHeight = yMax - yMin + 1;
+  Layout newLayout(newWidth, newHeight);
+  std::vector<T> newCells(newLayout.size());
+  for (int y = this->yBounds.min; y <= this->yBounds.max; y++) {
+    for (int x = this->xBounds.min; x <= this->xBounds.max; x++) {
+      size_t newIndex = newLayout.index(x - xMin, y - yMin);
+      newCells[newIndex] = std::move(this->cells[this->index(x, y)]);
+    }
+  }
+
+  this->layout = newLayout;
+  this->cells = std::move(newCells);
+  this->xOrigin = xMin;
+  this->yOrigin = yMin;
+  this->width = newWidth;
+  this->height = newHeight;
+  this->xBounds = newXBounds;
+  this->yBounds = newYBounds;
+}
+
+// Resets everything in storage outside the bounds back to T{}
+template <typename T, typename Layout, typename Access>
+void DenseGrid2D<T, Layout, Access>::unpad() {
+  for (int y = this->yOrigin; y < this->yOrigin + this->height; y++) {
+    for (int x = this->xOrigin; x < this->xOrigin + this->width; x++) {
+      if (!this->inBounds({x, y})) {
+        this->cells[this->index(x, y)] = T{};
+      }
+    }
+  }
+  this->border = 0;
+}
+
+template <typename T, typename Layout, typename Access>
+void DenseGrid2D<T, Layout, Access>::growHashed(const Point2D &point) {
+  // pending cells are tracked by storage index, which growing can change
+  this->flushHash();
+
+  bool wasEmpty = this->cells.empty();
+  Range<int> oldXBounds = this->xBounds;
+  Range<int> oldYBounds = this->yBounds;
+  this->grow(point);
+  this->pendingCells.assign(this->cells.size(), 0);
+
+  for (int y = this->yBounds.min; y <= this->yBounds.max; y++) {
+    for (int x = this->xBounds.min; x <= this->xBounds.max; x++) {
+      if (wasEmpty || !oldXBounds.contains(x) || !oldYBounds.contains(y)) {
+        this->zobrist->toggle(x, y, this->cells[this->index(x, y)]);
+      }
+    }
+  }
+}
+
+template <typename T, typename Layout, typename Access>
+void DenseGrid2D<T, Layout, Access>::flushHash() const {
+  for (const Point2D &point : this->pendingPoints) {
+    size_t index = this->index(point.x, point.y);
+    this->zobrist->toggle(point.x, point.y, this->cells[index]);
+    this->pendingCells[index] = 0;
+  }
+  this->pendingPoints.clear();
+}
+
+template <typename T, typename Layout, typename Access>
+T &DenseGrid2D<T, Layout, Access>::operator[](const Point2D &point) {
+  if (this->cells.empty() || !this->inBounds(point)) {
+    if (this->zobrist) {
+      this->growHashed(point);
+    } else {
+      this->grow(point);
+    }
+  }
+
+  size_t index = this->index(point.x, point.y);
+  if (this->zobrist && !this->pendingCells[index]) {
+    this->zobrist->toggle(point.x, point.y, this->cells[index]);
+    this->pendingCells[index] = 1;
+    this->pendingPoints.push_back(point);
+  }
+  return this->cells[index];
+}
+
+template <typename T, typename Layout, typename Access>
+const T &DenseGrid2D<T, Layout, Access>::operator[](
+    const Point2D &point) const {
+  if constexpr (Access::CHECKED) {
+    // the bounds plus the border, so reading the padding is fine but growth
+    // slack isn't
+    bool inReach = !this->cells.empty() &&
+                   point.x >= this->xBounds.min - this->border &&
+                   point.x <= this->xBounds.max + this->border &&
+                   point.y >= this->yBounds.min - this->border &&
+                   point.y <= this->yBounds.max + this->border;
+    if (!inReach) {
+      badGridAccess("DenseGrid2D::operator[]", point);
+    }
+  }
+  return this->cells[this->index(point.x, point.y)];
+}
+
+template <typename T, typename Layout, typename Access>
+bool DenseGrid2D<T, Layout, Access>::operator==(
+    const DenseGrid2D<T, Layout, Access> &other) const {
+  if (this->size() != other.size()) {
+    return false;
+  }
+  if (this->size() == 0) {
+    return true;
+  }
+  if (this->xBounds.min != other.xBounds.min ||
+      this->xBounds.max != other.xBounds.max ||
+      this->yBounds.min != other.yBounds.min ||
+      this->yBounds.max != other.yBounds.max) {
+    return false;
+  }
+
+  for (int y = this->yBounds.min; y <= this->yBounds.max; y++) {
+    for (int x = this->xBounds.min; x <= this->xBounds.max; x++) {
+      if (!((*this)[{x, y}] == other[{x, y}])) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+template <typename T, typename Layout, typename Access>
+const T &DenseGrid2D<T, Layout, Access>::at(const Point2D &point) const {
+  if (this->cells.empty() || !this->inBounds(point)) {
+    throwOutOfRange("DenseGrid2D::at", point);
+  }
+  return (*this)[point];
+}
+
+template <typename T, typename Layout, typename Access>
+typename DenseGrid2D<T, Layout, Access>::iterator
+DenseGrid2D<T, Layout, Access>::find(const Point2D &point) const {
+  if (this->cells.empty() || !this->inBounds(point)) {
+    return this->end();
+  }
+  int boundsWidth = this->xBounds.max - this->xBounds.min + 1;
+  long pos = (long)(point.y - this->yBounds.min) * boundsWidth +
+             (point.x - this->xBounds.min);
+  return iterator(this, pos, 1);
+}
+
+template <typename T, typename Layout, typename Access>
+typename DenseGrid2D<T, Layout, Access>::iterator
+DenseGrid2D<T, Layout, Access>::begin() const {
+  return iterator(this, 0, 1);
+}
+
+template <typename T, typename Layout, typename Access>
+typename DenseGrid2D<T, Layout, Access>::iterator
+DenseGrid2D<T, Layout, Access>::rbegin() const {
+  return iterator(this, (long)this->size() - 1, -1);
+}
+
+template <typename T, typename Layout, typename Access>
+typename DenseGrid2D<T, Layout, Access>::iterator
+DenseGrid2D<T, Layout, Access>::end() const {
+  return iterator(this, this->size(), 1);
+}
+
+template <typename T, typename Layout, typename Access>
+typename DenseGrid2D<T, Layout, Access>::iterator
+DenseGrid2D<T, Layout, Access>::rend() const {
+  return iterator(this, -1, -1);
+}
+
+template <typename T, typename Layout, typename Access>
+size_t DenseGrid2D<T, Layout, Access>::size() const {
+  if (this->cells.empty()) {
+    return 0;
+  }
+  return (size_t)(this->xBounds.max - this->xBounds.min + 1) *
+         (this->yBounds.max - this->yBounds.min + 1);
+}
+
+template <typename T, typename Layout, typename Access>
+bool DenseGrid2D<T, Layout, Access>::inBounds(const Point2D &point) const {
+  return this->xBounds.contains(point.x) && this->yBounds.contains(point.y);
+}
+
+template <typename T, typename Layout, typename Access>
+const T *DenseGrid2D<T, Layout, Access>::lookup(const Point2D &point) const {
+  if (this->cells.empty() || !this->inBounds(point)) {
+    return nullptr;
+  }
+  return &(*this)[point];
+}
+
+template <typename T, typename Layout, typename Access>
+NeighborRange<DenseGrid2D<T, Layout, Access>, T>
+DenseGrid2D<T, Layout, Access>::neighbors(const Point2D &point) const {
+  return this->neighbors(point, this->excludeDiagonals);
+}
+
+template <typename T, typename Layout, typename Access>
+NeighborRange<DenseGrid2D<T, Layout, Access>, T>
+DenseGrid2D<T, Layout, Access>::neighbors(const Point2D &point,
+                                          bool excludeDiagonals) const {
+  return NeighborRange<DenseGrid2D<T, Layout, Access>, T>(*this, point,
+                                                          excludeDiagonals);
+}
+
+template <typename T, typename Layout, typename Access>
+NeighborRange<DenseGrid2D<T, Layout, Access>, T, false>
+DenseGrid2D<T, Layout, Access>::interiorNeighbors(const Point2D &point) const {
+  return NeighborRange<DenseGrid2D<T, Layout, Access>, T, false>(
+      *this, point, this->excludeDiagonals);
+}
+
+template <typename T, typename Layout, typename Access>
+std::map<Point2D, T> DenseGrid2D<T, Layout, Access>::pointsAdjacent(
+    const Point2D &point) const {
+  std::map<Point2D, T> adjacent{};
+  for (const auto &pair : this->neighbors(point)) {
+    adjacent[pair.first] = pair.second;
+  }
+  return adjacent;
+}
+
+template <typename T, typename Layout, typename Access>
+DenseGrid2D<T, Layout, Access> DenseGrid2D<T, Layout, Access>::subRegion(
+    Range<int> xBounds, Range<int> yBounds) const {
+  DenseGrid2D<T, Layout, Access> newGrid(xBounds, yBounds);
+  newGrid.excludeDiagonals = this->excludeDiagonals;
+
+  for (int y = yBounds.min; y <= yBounds.max; y++) {
+    for (int x = xBounds.min; x <= xBounds.max; x++) {
+      newGrid[{x, y}] = this->at({x, y});
+    }
+  }
+
+  return newGrid;
+}
+
+template <typename T, typename Layout, typename Access>
+std::vector<T> DenseGrid2D<T, Layout, Access>::row(int y) const {
+  if constexpr (std::is_same_v<Layout, RowMajorLayout>) {
+    // the row is contiguous
+    auto first = this->cells.begin() + this->index(this->xBounds.min, y);
+    return std::vector<T>(first,
+                          first + (this->xBounds.max - this->xBounds.min + 1));
+  }
+
+  std::vector<T> vec{};
+  vec.reserve(this->xBounds.max - this->xBounds.min + 1);
+  for (int x = this->xBounds.min; x <= this->xBounds.max; x++) {
+    vec.push_back((*this)[{x, y}]);
+  }
+  return vec;
+}
+
+template <typename T, typename Layout, typename Access>
+std::vector<T> DenseGrid2D<T, Layout, Access>::col(int x) const {
+  std::vector<T> vec{};
+  vec.reserve(this->yBounds.max - this->yBounds.min + 1);
+  for (int y = this->yBounds.min; y <= this->yBounds.max; y++) {
+    vec.push_back((*this)[{x, y}]);
+  }
+  return vec;
+}
+
+template <typename T, typename Layout, typename Access>
+LineView<DenseGrid2D<T, Layout, Access>, T>
+DenseGrid2D<T, Layout, Access>::rowView(int y) const {
+  return this->regionView(this->xBounds, this->yBounds).row(y);
+}
+
+template <typename T, typename Layout, typename Access>
+LineView<DenseGrid2D<T, Layout, Access>, T>
+DenseGrid2D<T, Layout, Access>::colView(int x) const {
+  return this->regionView(this->xBounds, this->yBounds).col(x);
+}
+
+template <typename T, typename Layout, typename Access>
+RegionView<DenseGrid2D<T, Layout, Access>, T>
+DenseGrid2D<T, Layout, Access>::regionView(Range<int> xBounds,
+                                           Range<int> yBounds) const {
+  return RegionView<DenseGrid2D<T, Layout, Access>, T>(*this, xBounds, yBounds);
+}
+
+template <typename T, typename Layout, typename Access>
+RegionView<DenseGrid2D<T, Layout, Access>, T>
+DenseGrid2D<T, Layout, Access>::transposed() const {
+  return this->regionView(this->xBounds, this->yBounds).transposed();
+}
+
+template <typename T, typename Layout, typename Access>
+void DenseGrid2D<T, Layout, Access>::pad(const T &sentinel, int border) {
+  if (this->cells.empty()) {
+    return;
+  }
+  if (this->zobrist) {
+    // pending cells are tracked by storage index, which is about to change
+    this->flushHash();
+  }
+
+  // storage becomes exactly the bounds plus the border, all sentinel to start
+  int xMin = this->xBounds.min - border;
+  int yMin = this->yBounds.min - border;
+  int newWidth = this->xBounds.max - this->xBounds.min + 1 + 2 * border;
+  int newHeight = this->yBounds.max - this->yBounds.min + 1 + 2 * border;
+  Layout newLayout(newWidth, newHeight);
+  std::vector<T> newCells(newLayout.size(), sentinel);
+  for (int y = this->yBounds.min; y <= this->yBounds.max; y++) {
+    for (int x = this->xBounds.min; x <= this->xBounds.max; x++) {
+      size_t newIndex = newLayout.index(x - xMin, y - yMin);
+      newCells[newIndex] = std::move(this->cells[this->index(x, y)]);
+    }
+  }
+
+  this->layout = newLayout;
+  this->cells = std::move(newCells);
+  this->xOrigin = xMin;
+  this->yOrigin = yMin;
+  this->width = newWidth;
+  this->height = newHeight;
+  this->border = border;
+  if (this->zobrist) {
+    this->pendingCells.assign(this->cells.size(), 0);
+  }
+}
+
+template <typename T, typename Layout, typename Access>
+void DenseGrid2D<T, Layout, Access>::enableHashing(bool wide) {
+  this->zobrist.emplace(wide);
+  this->pendingPoints.clear();
+  this->pendingCells.assign(this->cells.size(), 0);
+  if (this->cells.empty()) {
+    return;
+  }
+
+  for (int y = this->yBounds.min; y <= this->yBounds.max; y++) {
+    for (int x = this->xBounds.min; x <= this->xBounds.max; x++) {
+      this->zobrist->toggle(x, y, this->cells[this->index(x, y)]);
+    }
+  }
+}
+
+template <typename T, typename Layout, typename Access>
+GridHash DenseGrid2D<T, Layout, Access>::hash() const {
+  if (!this->zobrist) {
+    throw std::runtime_error("DenseGrid2D::hash: hashing isn't enabled");
+  }
+  this->flushHash();
+  return this->zobrist->value();
+}
+
+template <typename T, typename Layout, typename Access>
+void DenseGrid2D<T, Layout, Access>::swap(
+    DenseGrid2D<T, Layout, Access> &other) {
+  std::swap(this->excludeDiagonals, other.excludeDiagonals);
+  std::swap(this->xBounds, other.xBounds);
+  std::swap(this->yBounds, other.yBounds);
+  std::swap(this->xOrigin, other.xOrigin);
+  std::swap(this->yOrigin, other.yOrigin);
+  std::swap(this->width, other.width);
+  std::swap(this->height, other.height);
+  std::swap(this->border, other.border);
+  std::swap(this->layout, other.layout);
+  this->cells.swap(other.cells);
+  this->zobrist.swap(other.zobrist);
+  this->pendingPoints.swap(other.pendingPoints);
+  this->pendingCells.swap(other.pendingCells);
+}
+
+template <typename T, typename Layout, typename Access>
+void DenseGrid2D<T, Layout, Access>::print() const {
+  for (int y = this->yBounds.min; y <= this->yBounds.max; y++) {
+    for (int x = this->xBounds.min; x <= this->xBounds.max; x++) {
+      std::cout << (*this)[{x, y}];
+    }
+    std::cout << std::endl;
+  }
+}
+
+template <typename T, typename Layout, typename Access>
+void swap(DenseGrid2D<T, Layout, Access> &a,
+          DenseGrid2D<T, Layout, Access> &b) {
+  a.swap(b);
+}
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef DOUBLEBUFFER_H
+#define DOUBLEBUFFER_H
+
+#include <utility>
+
+// A pair of grids for simulations where each step builds the next state from
+// the current one. Both start out as copies of the initial grid and flip()
+// swaps them in O(1), so as long as a step only writes cells next() already
+// has, stepping never allocates. next() still holds the state from two steps
+// back when a step starts.
+template <typename Grid>
+class DoubleBuffer {
+ public:
+  DoubleBuffer(const Grid &initial);
+  DoubleBuffer(Grid &&initial);
+
+  const Grid &current() const;
+  Grid &current();
+  Grid &next();
+  void flip();
+  // calls fn(current(), next()), flips, and returns the new current()
+  template <typename StepFn>
+  const Grid &step(StepFn fn);
+
+ private:
+  Grid front;
+  Grid back;
+};
+
+#include "doublebuffer.tpp"
+
+#endif
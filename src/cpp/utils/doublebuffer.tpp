@@ -0,0 +1,45 @@
+#ifndef DOUBLEBUFFER_TPP
+#define DOUBLEBUFFER_TPP
+
+#include <utility>
+
+#include "doublebuffer.h"
+
+template <typename Grid>
+DoubleBuffer<Grid>::DoubleBuffer(const Grid &initial)
+    : front(initial), back(initial) {}
+
+template <typename Grid>
+DoubleBuffer<Grid>::DoubleBuffer(Grid &&initial)
+    : front(std::move(initial)), back(this->front) {}
+
+template <typename Grid>
+const Grid &DoubleBuffer<Grid>::current() const {
+  return this->front;
+}
+
+template <typename Grid>
+Grid &DoubleBuffer<Grid>::current() {
+  return this->front;
+}
+
+template <typename Grid>
+Grid &DoubleBuffer<Grid>::next() {
+  return this->back;
+}
+
+template <typename Grid>
+void DoubleBuffer<Grid>::flip() {
+  using std::swap;
+  swap(this->front, this->back);
+}
+
+template <typename Grid>
+template <typename StepFn>
+const Grid &DoubleBuffer<Grid>::step(StepFn fn) {
+  fn(static_cast<const Grid &>(this->front), this->back);
+  this->flip();
+  return this->front;
+}
+
+#endif
@@ -0,0 +1,167 @@
+#include <fcntl.h>
+#include <file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+MappedInput::MappedInput(const std::string& filename) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1) {
+    std::cerr << "Could not open file." << std::endl;
+    return;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) == -1) {
+    std::cerr << "Could not stat file." << std::endl;
+    close(fd);
+    return;
+  }
+
+  this->length = info.st_size;
+  if (this->length > 0) {
+    void* addr = mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      std::cerr << "Could not map file." << std::endl;
+      this->length = 0;
+    } else {
+      // we only ever walk the file front to back
+      madvise(addr, this->length, MADV_SEQUENTIAL);
+      this->buffer = static_cast<const char*>(addr);
+      this->mapped = true;
+    }
+  }
+
+  // the mapping stays valid after the descriptor is closed
+  close(fd);
+}
+
+MappedInput::~MappedInput() { this->unmap(); }
+
+MappedInput::MappedInput(MappedInput&& other) noexcept {
+  *this = std::move(other);
+}
+
+MappedInput& MappedInput::operator=(MappedInput&& other) noexcept {
+  if (this != &other) {
+    this->unmap();
+    this->buffer = std::exchange(other.buffer, nullptr);
+    this->length = std::exchange(other.length, 0);
+    this->mapped = std::exchange(other.mapped, false);
+    this->indexed = std::exchange(other.indexed, false);
+    this->lineIndex = std::move(other.lineIndex);
+    other.lineIndex.clear();
+  }
+  return *this;
+}
+
+void MappedInput::unmap() {
+  if (this->mapped) {
+    munmap(const_cast<char*>(this->buffer), this->length);
+  }
+  this->buffer = nullptr;
+  this->length = 0;
+  this->mapped = false;
+  this->indexed = false;
+  this->lineIndex.clear();
+}
+
+bool MappedInput::isOpen() const { return this->mapped; }
+
+const char* MappedInput::data() const { return this->buffer; }
+
+size_t MappedInput::size() const { return this->length; }
+
+std::string_view MappedInput::view() const {
+  return std::string_view(this->buffer, this->length);
+}
+
+const std::vector<std::string_view>& MappedInput::lines() const {
+  if (this->indexed) {
+    return this->lineIndex;
+  }
+
+  std::string_view rest = this->view();
+  while (!rest.empty()) {
+    size_t pos = rest.find('\n');
+    if (pos == std::string_view::npos) {
+      // last line with no trailing newline
+      this->lineIndex.push_back(rest);
+      break;
+    }
+    this->lineIndex.push_back(rest.substr(0, pos));
+    rest.remove_prefix(pos + 1);
+  }
+
+  this->indexed = true;
+  return this->lineIndex;
+}
+
+std::string_view MappedInput::operator[](size_t idx) const {
+  return this->lines()[idx];
+}
+
+LineReader::LineReader(const std::string& filename, size_t chunkSize)
+    : file(filename, std::ios::binary), chunk(chunkSize) {
+  if (!this->file.is_open()) {
+    std::cerr << "Could not open file." << std::endl;
+  }
+}
+
+bool LineReader::isOpen() const { return this->file.is_open(); }
+
+bool LineReader::fill() {
+  if (!this->file) {
+    return false;
+  }
+  this->file.read(this->chunk.data(), this->chunk.size());
+  this->filled = this->file.gcount();
+  this->pos = 0;
+  return this->filled > 0;
+}
+
+bool LineReader::next(std::string_view& line) {
+  bool spilling = false;
+  this->spill.clear();
+
+  while (true) {
+    if (this->pos == this->filled && !this->fill()) {
+      // out of file; whatever was spilled is the final unterminated line
+      if (spilling) {
+        line = this->spill;
+        return true;
+      }
+      return false;
+    }
+
+    const char* start = this->chunk.data() + this->pos;
+    size_t available = this->filled - this->pos;
+    auto newline =
+        static_cast<const char*>(std::memchr(start, '\n', available));
+
+    if (newline != nullptr) {
+      size_t len = newline - start;
+      this->pos += len + 1;
+      if (spilling) {
+        this->spill.append(start, len);
+        line = this->spill;
+      } else {
+        line = std::string_view(start, len);
+      }
+      return true;
+    }
+
+    // line runs past the end of this chunk; stash what we have and refill
+    this->spill.append(start, available);
+    spilling = true;
+    this->pos = this->filled;
+  }
+}
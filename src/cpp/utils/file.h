@@ -1,12 +1,95 @@
 #ifndef FILE_H
 #define FILE_H
 
+#include <fstream>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <vector>
 
+// Integral and floating point types are parsed with std::from_chars; anything
+// else falls back to operator>>.
+template <typename T>
+T strToTemplate(std::string_view str);
+
 template <typename T>
 std::vector<T> fileLines(const std::string& filename);
 
+// Parses the first sizeof...(Ts) delimiter-separated fields of a line, e.g.
+// parseRecord<long, long, long>("50 98 2", ' '). Missing fields are left
+// value-initialized.
+template <typename... Ts>
+std::tuple<Ts...> parseRecord(std::string_view line, char delimiter);
+
+// parseRecord applied to every line of a file
+template <typename... Ts>
+std::vector<std::tuple<Ts...>> fileRecords(const std::string& filename,
+                                           char delimiter);
+
+// Calls fn(std::string_view) for every line of the file without ever holding
+// more than one chunk (plus one line) of it in memory.
+template <typename Fn>
+void streamLines(const std::string& filename, Fn fn);
+
+// Read-only, memory-mapped view of a whole file. The contents are never copied
+// onto the heap; lines() hands out string_views pointing straight into the
+// mapping, so the MappedInput must outlive anything built from them.
+class MappedInput {
+ public:
+  MappedInput(const std::string& filename);
+  ~MappedInput();
+
+  MappedInput(const MappedInput& other) = delete;
+  MappedInput& operator=(const MappedInput& other) = delete;
+  MappedInput(MappedInput&& other) noexcept;
+  MappedInput& operator=(MappedInput&& other) noexcept;
+
+  bool isOpen() const;
+  const char* data() const;
+  size_t size() const;
+  std::string_view view() const;
+
+  // Same splitting rules as std::getline: a trailing newline does not produce
+  // an extra empty line. The index is built on first use.
+  const std::vector<std::string_view>& lines() const;
+  std::string_view operator[](size_t idx) const;
+  auto begin() const { return this->lines().begin(); }
+  auto end() const { return this->lines().end(); }
+
+ private:
+  const char* buffer = nullptr;
+  size_t length = 0;
+  bool mapped = false;
+  mutable bool indexed = false;
+  mutable std::vector<std::string_view> lineIndex{};
+
+  void unmap();
+};
+
+// Bounded-memory line reader for inputs too big to load. The file is read in
+// fixed-size chunks; lines that fit in a chunk are handed out as views into it,
+// and only lines that straddle a chunk boundary get stitched together in a
+// reusable spill buffer.
+class LineReader {
+ public:
+  LineReader(const std::string& filename, size_t chunkSize = 1 << 16);
+
+  bool isOpen() const;
+
+  // Points `line` at the next line and returns true, or returns false once the
+  // file is exhausted. The view is only valid until the next call.
+  bool next(std::string_view& line);
+
+ private:
+  std::ifstream file;
+  std::vector<char> chunk;
+  size_t pos = 0;
+  size_t filled = 0;
+  std::string spill{};
+
+  bool fill();
+};
+
 #include "file.tpp"
 
 #endif
@@ -1,43 +1,97 @@
 #ifndef FILE_TPP
 #define FILE_TPP
 
+#include <charconv>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <tuple>
+#include <type_traits>
 
 #include "file.h"
 
 template <typename T>
-T strToTemplate(const std::string& str) {
-  std::stringstream ss(str);
-  T casted;
-  ss >> casted;
-  return casted;
-}
+T strToTemplate(std::string_view str) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return std::string(str);
+  } else if constexpr (std::is_same_v<T, std::string_view>) {
+    return str;
+  } else if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+                       !std::is_same_v<T, char>) {
+    // from_chars doesn't skip whitespace or accept a leading '+' like >> does
+    size_t first = str.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) {
+      return T{};
+    }
+    str.remove_prefix(first);
+    if (str[0] == '+') {
+      str.remove_prefix(1);
+    }
 
-template <>
-std::string strToTemplate<std::string>(const std::string& str) {
-  return str;
+    T casted{};
+    std::from_chars(str.data(), str.data() + str.size(), casted);
+    return casted;
+  } else {
+    // anything from_chars can't handle goes through operator>>
+    std::stringstream ss{std::string(str)};
+    T casted;
+    ss >> casted;
+    return casted;
+  }
 }
 
 template <typename T>
 std::vector<T> fileLines(const std::string& filename) {
-  std::ifstream input_file(filename);
+  std::vector<T> lines{};
+  streamLines(filename, [&lines](std::string_view line) {
+    lines.push_back(strToTemplate<T>(line));
+  });
+  return lines;
+}
 
-  if (!input_file.is_open()) {
-    std::cerr << "Could not open file." << std::endl;
-    return {};
+template <typename T>
+void parseField(std::string_view& rest, char delimiter, T& field) {
+  // runs of delimiters count as one, same as strSplit
+  size_t start = rest.find_first_not_of(delimiter);
+  if (start == std::string_view::npos) {
+    rest = std::string_view{};
+    return;
   }
+  rest.remove_prefix(start);
 
-  std::vector<T> lines{};
-  std::string line;
-  while (std::getline(input_file, line)) {
-    T casted = strToTemplate<T>(line);
-    lines.push_back(casted);
-  }
+  size_t end = rest.find(delimiter);
+  field = strToTemplate<T>(rest.substr(0, end));
+  rest.remove_prefix(end == std::string_view::npos ? rest.size() : end);
+}
 
-  input_file.close();
-  return lines;
+template <typename... Ts>
+std::tuple<Ts...> parseRecord(std::string_view line, char delimiter) {
+  std::tuple<Ts...> record{};
+  std::apply(
+      [&line, delimiter](Ts&... fields) {
+        (parseField(line, delimiter, fields), ...);
+      },
+      record);
+  return record;
+}
+
+template <typename... Ts>
+std::vector<std::tuple<Ts...>> fileRecords(const std::string& filename,
+                                           char delimiter) {
+  std::vector<std::tuple<Ts...>> records{};
+  streamLines(filename, [&records, delimiter](std::string_view line) {
+    records.push_back(parseRecord<Ts...>(line, delimiter));
+  });
+  return records;
+}
+
+template <typename Fn>
+void streamLines(const std::string& filename, Fn fn) {
+  LineReader reader(filename);
+  std::string_view line;
+  while (reader.next(line)) {
+    fn(line);
+  }
 }
 
 #endif
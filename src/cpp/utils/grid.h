@@ -2,73 +2,455 @@
 #define GRID_H
 
 #include <range.h>
+#include <zobrist.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+class SnapshotReader;
+
+// Everything here is constexpr and defined inline, so points cost nothing in
+// hot loops and work in constant expressions.
 class Point2D {
  public:
   int x;
   int y;
 
-  Point2D() : x(0), y(0){};
-  Point2D(int x, int y) : x(x), y(y){};
+  constexpr Point2D() : x(0), y(0){};
+  constexpr Point2D(int x, int y) : x(x), y(y){};
+
+  constexpr bool operator==(const Point2D &other) const {
+    return this->x == other.x && this->y == other.y;
+  }
+  constexpr bool operator!=(const Point2D &other) const {
+    return !(*this == other);
+  }
+  constexpr Point2D operator+(const Point2D &other) const {
+    return Point2D(this->x + other.x, this->y + other.y);
+  }
+  constexpr Point2D operator-(const Point2D &other) const {
+    return Point2D(this->x - other.x, this->y - other.y);
+  }
+  constexpr Point2D operator*(int multiplicand) const {
+    return Point2D(this->x * multiplicand, this->y * multiplicand);
+  }
+  constexpr Point2D operator/(int divisor) const {
+    return Point2D(this->x / divisor, this->y / divisor);
+  }
+  // Only needed to make this efficiently work as a key to std::map. Choosing
+  // row-major so that iteration matches input files
+  constexpr bool operator<(const Point2D &other) const {
+    if (this->y == other.y) {
+      return this->x < other.x;
+    } else {
+      return this->y < other.y;
+    }
+  }
+
+  constexpr bool isAdjacent(const Point2D &other) const {
+    return this->isAdjacent(other, true);
+  }
+  constexpr bool isAdjacent(const Point2D &other,
+                            bool excludeDiagonals) const {
+    int xDistance = absolute(other.x - this->x);
+    int yDistance = absolute(other.y - this->y);
+
+    if (excludeDiagonals) {
+      return (xDistance <= 1 && yDistance == 0) ||
+             (xDistance == 0 && yDistance <= 1);
+    } else {
+      return xDistance <= 1 && yDistance <= 1;
+    }
+  }
+  constexpr int manhattanDistanceFrom(const Point2D &other) const {
+    return absolute(other.x - this->x) + absolute(other.y - this->y);
+  }
+
+  // Both coordinates in one 64-bit key, x in the high half. Every point has
+  // its own key, and unpack(point.pack()) == point.
+  constexpr uint64_t pack() const {
+    return ((uint64_t)(uint32_t)this->x << 32) | (uint32_t)this->y;
+  }
+  static constexpr Point2D unpack(uint64_t key) {
+    return Point2D((int32_t)(uint32_t)(key >> 32), (int32_t)(uint32_t)key);
+  }
+
+ private:
+  // std::abs isn't constexpr until C++23
+  static constexpr int absolute(int value) {
+    return value < 0 ? -value : value;
+  }
+};
+
+constexpr Point2D DELTA_UP_LEFT{-1, -1};
+constexpr Point2D DELTA_UP{0, -1};
+constexpr Point2D DELTA_UP_RIGHT{1, -1};
+constexpr Point2D DELTA_LEFT{-1, 0};
+constexpr Point2D DELTA_RIGHT{1, 0};
+constexpr Point2D DELTA_DOWN_LEFT{-1, 1};
+constexpr Point2D DELTA_DOWN{0, 1};
+constexpr Point2D DELTA_DOWN_RIGHT{1, 1};
+
+namespace std {
+// For std::unordered_map and friends. The packed key goes through
+// splitmix64's finalizer, so neighboring points land in unrelated buckets.
+template <>
+struct hash<Point2D> {
+  size_t operator()(const Point2D &point) const {
+    uint64_t value = point.pack();
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+    return value ^ (value >> 31);
+  }
+};
+}  // namespace std
+
+// Neighbor offsets as {x, y}, in row-major order so neighbors come out in the
+// same order a std::map<Point2D, T> would hold them
+constexpr int ORTHOGONAL_DELTAS[4][2] = {{0, -1}, {-1, 0}, {1, 0}, {0, 1}};
+constexpr int ALL_DELTAS[8][2] = {{-1, -1}, {0, -1}, {1, -1}, {-1, 0},
+                                  {1, 0},   {-1, 1}, {0, 1},  {1, 1}};
+
+// Access policies for the grids' const operator[], the fast read. With
+// CheckedAccess, reading a cell the grid doesn't have calls badGridAccess().
+// UncheckedAccess indexes straight in and trusts the caller. DefaultAccess is
+// CheckedAccess in debug builds and UncheckedAccess under NDEBUG, so the same
+// code gets checked while it's being written and runs raw once it works. at()
+// checks whatever the policy is.
+struct CheckedAccess {
+  static constexpr bool CHECKED = true;
+};
+struct UncheckedAccess {
+  static constexpr bool CHECKED = false;
+};
+#ifdef NDEBUG
+using DefaultAccess = UncheckedAccess;
+#else
+using DefaultAccess = CheckedAccess;
+#endif
+
+// throws std::out_of_range naming the grid (where) and the point
+[[noreturn]] void throwOutOfRange(const char *where, const Point2D &point);
+// In debug builds, prints where and point and fails an assert; under NDEBUG
+// it's throwOutOfRange
+[[noreturn]] void badGridAccess(const char *where, const Point2D &point);
 
-  bool operator==(const Point2D &other) const;
-  bool operator!=(const Point2D &other) const;
-  Point2D operator+(const Point2D &other) const;
-  Point2D operator-(const Point2D &other) const;
-  Point2D operator*(int multiplicand) const;
-  Point2D operator/(int divisor) const;
-  bool operator<(const Point2D &other) const;
+// Lazy range over the 4 or 8 neighbors of a cell, yielding (point, value)
+// pairs without allocating anything. Checked ranges skip neighbors the grid
+// doesn't have. Unchecked ranges assume every neighbor exists, so only use
+// them for interior cells of grids with a const operator[] (DenseGrid2D).
+template <typename Grid, typename T, bool CHECKED = true>
+class NeighborRange {
+ public:
+  class iterator {
+   public:
+    using value_type = std::pair<Point2D, const T &>;
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    struct pointer {
+      value_type pair;
+      const value_type *operator->() const { return &this->pair; }
+    };
+
+    iterator(const NeighborRange *range, int index);
+
+    reference operator*() const { return {this->point, *this->value}; }
+    pointer operator->() const { return pointer{**this}; }
+    iterator &operator++();
+    bool operator==(const iterator &other) const;
+    bool operator!=(const iterator &other) const;
+
+   private:
+    const NeighborRange *range;
+    int index;
+    Point2D point{};
+    const T *value = nullptr;
 
-  bool isAdjacent(const Point2D &other) const;
-  bool isAdjacent(const Point2D &other, bool excludeDiagonals) const;
-  int manhattanDistanceFrom(const Point2D &other) const;
+    // moves forward to the next neighbor the grid has
+    void settle();
+  };
+
+  NeighborRange(const Grid &grid, const Point2D &center,
+                bool excludeDiagonals);
+
+  iterator begin() const;
+  iterator end() const;
+
+ private:
+  const Grid *grid;
+  Point2D center;
+  const int (*deltas)[2];
+  int count;
 };
 
-const Point2D DELTA_UP_LEFT{-1, -1};
-const Point2D DELTA_UP{0, -1};
-const Point2D DELTA_UP_RIGHT{1, -1};
-const Point2D DELTA_LEFT{-1, 0};
-const Point2D DELTA_RIGHT{1, 0};
-const Point2D DELTA_DOWN_LEFT{-1, 1};
-const Point2D DELTA_DOWN{0, 1};
-const Point2D DELTA_DOWN_RIGHT{1, 1};
+// Non-owning view of a straight run of cells, like a row or a column. Views
+// read through to the grid, so they see later writes and must not outlive it.
+// Reading a cell the grid doesn't have throws std::out_of_range, like at().
+template <typename Grid, typename T>
+class LineView {
+ public:
+  class iterator {
+   public:
+    using value_type = T;
+    using reference = const T &;
+    using pointer = const T *;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    iterator(const LineView *view, int index) : view(view), index(index) {}
+
+    reference operator*() const { return (*this->view)[this->index]; }
+    pointer operator->() const { return &**this; }
+    iterator &operator++();
+    iterator operator++(int);
+    bool operator==(const iterator &other) const;
+    bool operator!=(const iterator &other) const;
+
+   private:
+    const LineView *view;
+    int index;
+  };
 
-template <typename T>
+  LineView(const Grid &grid, const Point2D &start, const Point2D &step,
+           int length);
+
+  const T &operator[](int index) const;
+  // element-wise, like comparing the vectors row() and col() return
+  bool operator==(const LineView &other) const;
+  bool operator!=(const LineView &other) const;
+
+  iterator begin() const;
+  iterator end() const;
+  int size() const;
+  size_t hash() const;
+  std::vector<T> toVector() const;
+
+ private:
+  const Grid *grid;
+  Point2D start;
+  Point2D step;
+  int length;
+};
+
+template <typename Grid, typename T>
+using RowView = LineView<Grid, T>;
+template <typename Grid, typename T>
+using ColView = LineView<Grid, T>;
+
+// Non-owning view of a rectangle of a grid, in the grid's own coordinates.
+// A transposed view swaps x and y, so its rows are the grid's columns. Same
+// caveats as LineView.
+template <typename Grid, typename T>
+class RegionView {
+ public:
+  // Iterates the view row-major, yielding (point, value) pairs in view
+  // coordinates
+  class iterator {
+   public:
+    using value_type = std::pair<Point2D, const T &>;
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    struct pointer {
+      value_type pair;
+      const value_type *operator->() const { return &this->pair; }
+    };
+
+    iterator(const RegionView *view, long pos) : view(view), pos(pos) {}
+
+    reference operator*() const;
+    pointer operator->() const { return pointer{**this}; }
+    iterator &operator++();
+    bool operator==(const iterator &other) const;
+    bool operator!=(const iterator &other) const;
+
+   private:
+    const RegionView *view;
+    long pos;
+  };
+
+  Range<int> xBounds;
+  Range<int> yBounds;
+
+  RegionView(const Grid &grid, Range<int> xBounds, Range<int> yBounds,
+             bool isTransposed = false);
+
+  const T &operator[](const Point2D &point) const;
+  // same shape and the same cells, wherever in their grids the regions are
+  bool operator==(const RegionView &other) const;
+  bool operator!=(const RegionView &other) const;
+
+  iterator begin() const;
+  iterator end() const;
+  size_t size() const;
+  size_t hash() const;
+
+  LineView<Grid, T> row(int y) const;
+  LineView<Grid, T> col(int x) const;
+  RegionView transposed() const;
+
+ private:
+  const Grid *grid;
+  bool isTransposed;
+
+  Point2D gridPoint(const Point2D &point) const;
+};
+
+template <typename T, typename Access = DefaultAccess>
 class Grid2D {
+  struct Cell {
+    T value;
+    // waiting in pending for hash() to toggle value back in
+    mutable bool pending = false;
+  };
+  using CellMap = std::map<Point2D, Cell>;
+
  public:
+  // Iterates cells in row-major order (backwards from rbegin()), yielding
+  // (point, value) pairs
+  template <typename MapIterator>
+  class basic_iterator {
+   public:
+    using value_type = std::pair<Point2D, const T &>;
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    struct pointer {
+      value_type pair;
+      const value_type *operator->() const { return &this->pair; }
+    };
+
+    basic_iterator(MapIterator it) : it(it) {}
+
+    reference operator*() const {
+      return {this->it->first, this->it->second.value};
+    }
+    pointer operator->() const { return pointer{**this}; }
+    basic_iterator &operator++() {
+      ++this->it;
+      return *this;
+    }
+    basic_iterator operator++(int) {
+      basic_iterator old = *this;
+      ++this->it;
+      return old;
+    }
+    bool operator==(const basic_iterator &other) const {
+      return this->it == other.it;
+    }
+    bool operator!=(const basic_iterator &other) const {
+      return this->it != other.it;
+    }
+
+   private:
+    MapIterator it;
+  };
+  using iterator = basic_iterator<typename CellMap::const_iterator>;
+  using reverse_iterator =
+      basic_iterator<typename CellMap::const_reverse_iterator>;
+
   bool excludeDiagonals = false;
   Range<int> xBounds{0, 0};
   Range<int> yBounds{0, 0};
 
   Grid2D();
   Grid2D(bool excludeDiagonals);
+  // settles other's pending cells first; see hash()
+  Grid2D(const Grid2D<T, Access> &other);
+  Grid2D(Grid2D<T, Access> &&other) = default;
 
-  Grid2D<T> operator=(const Grid2D<T> &other);
+  Grid2D<T, Access> &operator=(const Grid2D<T, Access> &other);
+  Grid2D<T, Access> &operator=(Grid2D<T, Access> &&other) = default;
   T &operator[](const Point2D &point);
-  bool operator==(const Grid2D<T> &other) const;
+  // never inserts; the cell has to exist (see Access)
+  const T &operator[](const Point2D &point) const;
+  bool operator==(const Grid2D<T, Access> &other) const;
 
-  auto at(const Point2D &point) const;
-  auto find(const Point2D &point) const;
-  auto begin() const;
-  auto rbegin() const;
-  auto end() const;
-  auto size() const;
+  const T &at(const Point2D &point) const;
+  iterator find(const Point2D &point) const;
+  iterator begin() const;
+  reverse_iterator rbegin() const;
+  iterator end() const;
+  size_t size() const;
 
   bool inBounds(const Point2D &point) const;
+  // the cell at point, or nullptr if there isn't one
+  const T *lookup(const Point2D &point) const;
+  // neighbors of point, diagonals included unless excludeDiagonals is set
+  NeighborRange<Grid2D<T, Access>, T> neighbors(const Point2D &point) const;
+  NeighborRange<Grid2D<T, Access>, T> neighbors(const Point2D &point,
+                                                bool excludeDiagonals) const;
   std::map<Point2D, T> pointsAdjacent(const Point2D &point) const;
-  Grid2D<T> subRegion(Range<int> xBounds, Range<int> yBounds) const;
+  Grid2D<T, Access> subRegion(Range<int> xBounds, Range<int> yBounds) const;
   std::vector<T> row(int y) const;
   std::vector<T> col(int x) const;
+  // non-owning versions of the above; see LineView and RegionView
+  LineView<Grid2D<T, Access>, T> rowView(int y) const;
+  LineView<Grid2D<T, Access>, T> colView(int x) const;
+  RegionView<Grid2D<T, Access>, T> regionView(Range<int> xBounds,
+                                              Range<int> yBounds) const;
+  RegionView<Grid2D<T, Access>, T> transposed() const;
   void print() const;
 
+  // Starts keeping a Zobrist hash of every cell, updated in O(1) per write on
+  // top of the map lookup the write does anyway. Pass wide for 128 bits
+  // instead of 64
+  void enableHashing(bool wide = false);
+  // throws if hashing isn't enabled
+  GridHash hash() const;
+  // O(1); swaps everything, bounds and hashing state included
+  void swap(Grid2D<T, Access> &other);
+
  private:
-  std::map<Point2D, T> map{};
+  // fills the map in one sorted pass instead of through operator[]
+  friend class SnapshotReader;
+
+  CellMap map{};
+
+  // see DenseGrid2D; cells handed out by operator[] wait here until hash().
+  // Map iterators stay valid since cells are never erased
+  mutable std::optional<ZobristHash> zobrist{};
+  mutable std::vector<typename CellMap::const_iterator> pending{};
+
+  void flushHash() const;
+};
+
+namespace std {
+template <typename Grid, typename T>
+struct hash<LineView<Grid, T>> {
+  size_t operator()(const LineView<Grid, T> &view) const {
+    return view.hash();
+  }
+};
+
+template <typename Grid, typename T>
+struct hash<RegionView<Grid, T>> {
+  size_t operator()(const RegionView<Grid, T> &view) const {
+    return view.hash();
+  }
 };
+}  // namespace std
+
+template <typename T, typename Access>
+void swap(Grid2D<T, Access> &a, Grid2D<T, Access> &b);
 
 Grid2D<char> linesToGrid(const std::vector<std::string> &lines);
+Grid2D<char> linesToGrid(const std::vector<std::string_view> &lines);
+// Same as above for any grid type, e.g. linesToGrid<DenseGrid2D<char>>(lines)
+template <typename Grid, typename Line>
+Grid linesToGrid(const std::vector<Line> &lines);
 
 #include "grid.tpp"
 
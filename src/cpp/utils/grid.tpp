@@ -2,39 +2,327 @@
 #define GRID_TPP
 
 #include <range.h>
+#include <zobrist.h>
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
 #include <map>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "grid.h"
 
-template <typename T>
-Grid2D<T>::Grid2D() {}
+template <typename Grid, typename T, bool CHECKED>
+NeighborRange<Grid, T, CHECKED>::iterator::iterator(const NeighborRange *range,
+                                                    int index)
+    : range(range), index(index) {
+  this->settle();
+}
 
-template <typename T>
-Grid2D<T>::Grid2D(bool excludeDiagonals) {
-  this->excludeDiagonals = excludeDiagonals;
-  this->map = std::map<Point2D, T>{};
+template <typename Grid, typename T, bool CHECKED>
+void NeighborRange<Grid, T, CHECKED>::iterator::settle() {
+  for (; this->index < this->range->count; this->index++) {
+    const int *delta = this->range->deltas[this->index];
+    this->point = Point2D(this->range->center.x + delta[0],
+                          this->range->center.y + delta[1]);
+    if constexpr (CHECKED) {
+      this->value = this->range->grid->lookup(this->point);
+      if (this->value != nullptr) {
+        return;
+      }
+    } else {
+      this->value = &(*this->range->grid)[this->point];
+      return;
+    }
+  }
 }
 
-template <typename T>
-Grid2D<T> Grid2D<T>::operator=(const Grid2D<T> &other) {
-  this->map.clear();
-  this->excludeDiagonals = other.excludeDiagonals;
+template <typename Grid, typename T, bool CHECKED>
+typename NeighborRange<Grid, T, CHECKED>::iterator &
+NeighborRange<Grid, T, CHECKED>::iterator::operator++() {
+  this->index++;
+  this->settle();
+  return *this;
+}
+
+template <typename Grid, typename T, bool CHECKED>
+bool NeighborRange<Grid, T, CHECKED>::iterator::operator==(
+    const iterator &other) const {
+  return this->range == other.range && this->index == other.index;
+}
+
+template <typename Grid, typename T, bool CHECKED>
+bool NeighborRange<Grid, T, CHECKED>::iterator::operator!=(
+    const iterator &other) const {
+  return !(*this == other);
+}
+
+template <typename Grid, typename T, bool CHECKED>
+NeighborRange<Grid, T, CHECKED>::NeighborRange(const Grid &grid,
+                                               const Point2D &center,
+                                               bool excludeDiagonals)
+    : grid(&grid), center(center) {
+  if (excludeDiagonals) {
+    this->deltas = ORTHOGONAL_DELTAS;
+    this->count = 4;
+  } else {
+    this->deltas = ALL_DELTAS;
+    this->count = 8;
+  }
+}
+
+template <typename Grid, typename T, bool CHECKED>
+typename NeighborRange<Grid, T, CHECKED>::iterator
+NeighborRange<Grid, T, CHECKED>::begin() const {
+  return iterator(this, 0);
+}
+
+template <typename Grid, typename T, bool CHECKED>
+typename NeighborRange<Grid, T, CHECKED>::iterator
+NeighborRange<Grid, T, CHECKED>::end() const {
+  return iterator(this, this->count);
+}
 
-  for (int y = other.yBounds.min; y <= other.yBounds.max; y++) {
-    for (int x = other.xBounds.min; x <= other.xBounds.max; x++) {
-      this->map[{x, y}] = other.at({x, y});
+template <typename Grid, typename T>
+typename LineView<Grid, T>::iterator &
+LineView<Grid, T>::iterator::operator++() {
+  this->index++;
+  return *this;
+}
+
+template <typename Grid, typename T>
+typename LineView<Grid, T>::iterator LineView<Grid, T>::iterator::operator++(
+    int) {
+  iterator old = *this;
+  this->index++;
+  return old;
+}
+
+template <typename Grid, typename T>
+bool LineView<Grid, T>::iterator::operator==(const iterator &other) const {
+  return this->view == other.view && this->index == other.index;
+}
+
+template <typename Grid, typename T>
+bool LineView<Grid, T>::iterator::operator!=(const iterator &other) const {
+  return !(*this == other);
+}
+
+template <typename Grid, typename T>
+LineView<Grid, T>::LineView(const Grid &grid, const Point2D &start,
+                            const Point2D &step, int length)
+    : grid(&grid), start(start), step(step), length(length) {}
+
+template <typename Grid, typename T>
+const T &LineView<Grid, T>::operator[](int index) const {
+  Point2D point = this->start + this->step * index;
+  const T *cell = this->grid->lookup(point);
+  if (cell == nullptr) {
+    throwOutOfRange("LineView::operator[]", point);
+  }
+  return *cell;
+}
+
+template <typename Grid, typename T>
+bool LineView<Grid, T>::operator==(const LineView &other) const {
+  if (this->length != other.length) {
+    return false;
+  }
+  for (int i = 0; i < this->length; i++) {
+    if (!((*this)[i] == other[i])) {
+      return false;
     }
   }
+  return true;
+}
 
+template <typename Grid, typename T>
+bool LineView<Grid, T>::operator!=(const LineView &other) const {
+  return !(*this == other);
+}
+
+template <typename Grid, typename T>
+typename LineView<Grid, T>::iterator LineView<Grid, T>::begin() const {
+  return iterator(this, 0);
+}
+
+template <typename Grid, typename T>
+typename LineView<Grid, T>::iterator LineView<Grid, T>::end() const {
+  return iterator(this, this->length);
+}
+
+template <typename Grid, typename T>
+int LineView<Grid, T>::size() const {
+  return this->length;
+}
+
+template <typename Grid, typename T>
+size_t LineView<Grid, T>::hash() const {
+  size_t hash = this->length;
+  for (const T &value : *this) {
+    hash ^= std::hash<T>{}(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
+template <typename Grid, typename T>
+std::vector<T> LineView<Grid, T>::toVector() const {
+  return std::vector<T>(this->begin(), this->end());
+}
+
+template <typename Grid, typename T>
+typename RegionView<Grid, T>::iterator::reference
+RegionView<Grid, T>::iterator::operator*() const {
+  int width = this->view->xBounds.max - this->view->xBounds.min + 1;
+  Point2D point(this->view->xBounds.min + this->pos % width,
+                this->view->yBounds.min + this->pos / width);
+  return {point, (*this->view)[point]};
+}
+
+template <typename Grid, typename T>
+typename RegionView<Grid, T>::iterator &
+RegionView<Grid, T>::iterator::operator++() {
+  this->pos++;
   return *this;
 }
 
-template <typename T>
-T &Grid2D<T>::operator[](const Point2D &point) {
+template <typename Grid, typename T>
+bool RegionView<Grid, T>::iterator::operator==(const iterator &other) const {
+  return this->view == other.view && this->pos == other.pos;
+}
+
+template <typename Grid, typename T>
+bool RegionView<Grid, T>::iterator::operator!=(const iterator &other) const {
+  return !(*this == other);
+}
+
+template <typename Grid, typename T>
+RegionView<Grid, T>::RegionView(const Grid &grid, Range<int> xBounds,
+                                Range<int> yBounds, bool isTransposed)
+    : xBounds(xBounds),
+      yBounds(yBounds),
+      grid(&grid),
+      isTransposed(isTransposed) {}
+
+template <typename Grid, typename T>
+Point2D RegionView<Grid, T>::gridPoint(const Point2D &point) const {
+  return this->isTransposed ? Point2D(point.y, point.x) : point;
+}
+
+template <typename Grid, typename T>
+const T &RegionView<Grid, T>::operator[](const Point2D &point) const {
+  const T *cell = this->grid->lookup(this->gridPoint(point));
+  if (cell == nullptr) {
+    throwOutOfRange("RegionView::operator[]", this->gridPoint(point));
+  }
+  return *cell;
+}
+
+template <typename Grid, typename T>
+bool RegionView<Grid, T>::operator==(const RegionView &other) const {
+  int width = this->xBounds.max - this->xBounds.min;
+  int height = this->yBounds.max - this->yBounds.min;
+  if (width != other.xBounds.max - other.xBounds.min ||
+      height != other.yBounds.max - other.yBounds.min) {
+    return false;
+  }
+
+  for (int y = 0; y <= height; y++) {
+    if (this->row(this->yBounds.min + y) != other.row(other.yBounds.min + y)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Grid, typename T>
+bool RegionView<Grid, T>::operator!=(const RegionView &other) const {
+  return !(*this == other);
+}
+
+template <typename Grid, typename T>
+typename RegionView<Grid, T>::iterator RegionView<Grid, T>::begin() const {
+  return iterator(this, 0);
+}
+
+template <typename Grid, typename T>
+typename RegionView<Grid, T>::iterator RegionView<Grid, T>::end() const {
+  return iterator(this, this->size());
+}
+
+template <typename Grid, typename T>
+size_t RegionView<Grid, T>::size() const {
+  return (size_t)(this->xBounds.max - this->xBounds.min + 1) *
+         (this->yBounds.max - this->yBounds.min + 1);
+}
+
+template <typename Grid, typename T>
+size_t RegionView<Grid, T>::hash() const {
+  size_t hash = this->xBounds.max - this->xBounds.min + 1;
+  for (int y = this->yBounds.min; y <= this->yBounds.max; y++) {
+    size_t rowHash = this->row(y).hash();
+    hash ^= rowHash + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
+template <typename Grid, typename T>
+LineView<Grid, T> RegionView<Grid, T>::row(int y) const {
+  return LineView<Grid, T>(
+      *this->grid, this->gridPoint({this->xBounds.min, y}),
+      this->isTransposed ? DELTA_DOWN : DELTA_RIGHT,
+      this->xBounds.max - this->xBounds.min + 1);
+}
+
+template <typename Grid, typename T>
+LineView<Grid, T> RegionView<Grid, T>::col(int x) const {
+  return LineView<Grid, T>(
+      *this->grid, this->gridPoint({x, this->yBounds.min}),
+      this->isTransposed ? DELTA_RIGHT : DELTA_DOWN,
+      this->yBounds.max - this->yBounds.min + 1);
+}
+
+template <typename Grid, typename T>
+RegionView<Grid, T> RegionView<Grid, T>::transposed() const {
+  return RegionView<Grid, T>(*this->grid, this->yBounds, this->xBounds,
+                             !this->isTransposed);
+}
+
+template <typename T, typename Access>
+Grid2D<T, Access>::Grid2D() {}
+
+template <typename T, typename Access>
+Grid2D<T, Access>::Grid2D(bool excludeDiagonals) {
+  this->excludeDiagonals = excludeDiagonals;
+  this->map = CellMap{};
+}
+
+template <typename T, typename Access>
+Grid2D<T, Access>::Grid2D(const Grid2D<T, Access> &other) {
+  // other's pending iterators point into its own map, so they can't be copied
+  if (other.zobrist) {
+    other.flushHash();
+  }
+  this->excludeDiagonals = other.excludeDiagonals;
+  this->xBounds = other.xBounds;
+  this->yBounds = other.yBounds;
+  this->map = other.map;
+  this->zobrist = other.zobrist;
+}
+
+template <typename T, typename Access>
+Grid2D<T, Access> &Grid2D<T, Access>::operator=(
+    const Grid2D<T, Access> &other) {
+  Grid2D<T, Access> copy(other);
+  this->swap(copy);
+  return *this;
+}
+
+template <typename T, typename Access>
+T &Grid2D<T, Access>::operator[](const Point2D &point) {
   if (this->size() == 0) {
     this->xBounds.min = point.x;
     this->xBounds.max = point.x;
@@ -47,11 +335,19 @@ T &Grid2D<T>::operator[](const Point2D &point) {
     this->yBounds.max = std::max(this->yBounds.max, point.y);
   }
 
-  return this->map[point];
+  auto [found, inserted] = this->map.try_emplace(point);
+  if (this->zobrist && !found->second.pending) {
+    if (!inserted) {
+      this->zobrist->toggle(point.x, point.y, found->second.value);
+    }
+    found->second.pending = true;
+    this->pending.push_back(found);
+  }
+  return found->second.value;
 }
 
-template <typename T>
-bool Grid2D<T>::operator==(const Grid2D<T> &other) const {
+template <typename T, typename Access>
+bool Grid2D<T, Access>::operator==(const Grid2D<T, Access> &other) const {
   if (this->size() != other.size()) {
     return false;
   }
@@ -70,64 +366,90 @@ bool Grid2D<T>::operator==(const Grid2D<T> &other) const {
   return true;
 }
 
-template <typename T>
-auto Grid2D<T>::at(const Point2D &point) const {
-  return this->map.at(point);
+template <typename T, typename Access>
+const T &Grid2D<T, Access>::operator[](const Point2D &point) const {
+  auto found = this->map.find(point);
+  if constexpr (Access::CHECKED) {
+    if (found == this->map.end()) {
+      badGridAccess("Grid2D::operator[]", point);
+    }
+  }
+  return found->second.value;
+}
+
+template <typename T, typename Access>
+const T &Grid2D<T, Access>::at(const Point2D &point) const {
+  const T *cell = this->lookup(point);
+  if (cell == nullptr) {
+    throwOutOfRange("Grid2D::at", point);
+  }
+  return *cell;
 }
 
-template <typename T>
-auto Grid2D<T>::find(const Point2D &point) const {
-  return this->map.find(point);
+template <typename T, typename Access>
+typename Grid2D<T, Access>::iterator Grid2D<T, Access>::find(
+    const Point2D &point) const {
+  return iterator(this->map.find(point));
 }
 
-template <typename T>
-auto Grid2D<T>::begin() const {
-  return this->map.begin();
+template <typename T, typename Access>
+typename Grid2D<T, Access>::iterator Grid2D<T, Access>::begin() const {
+  return iterator(this->map.begin());
 }
 
-template <typename T>
-auto Grid2D<T>::rbegin() const {
-  return this->map.rbegin();
+template <typename T, typename Access>
+typename Grid2D<T, Access>::reverse_iterator Grid2D<T, Access>::rbegin()
+    const {
+  return reverse_iterator(this->map.rbegin());
 }
 
-template <typename T>
-auto Grid2D<T>::end() const {
-  return this->map.end();
+template <typename T, typename Access>
+typename Grid2D<T, Access>::iterator Grid2D<T, Access>::end() const {
+  return iterator(this->map.end());
 }
 
-template <typename T>
-auto Grid2D<T>::size() const {
+template <typename T, typename Access>
+size_t Grid2D<T, Access>::size() const {
   return this->map.size();
 }
 
-template <typename T>
-bool Grid2D<T>::inBounds(const Point2D &point) const {
+template <typename T, typename Access>
+bool Grid2D<T, Access>::inBounds(const Point2D &point) const {
   return this->xBounds.contains(point.x) && this->yBounds.contains(point.y);
 }
 
-template <typename T>
-std::map<Point2D, T> Grid2D<T>::pointsAdjacent(const Point2D &point) const {
-  std::map<Point2D, T> adjacent{};
+template <typename T, typename Access>
+const T *Grid2D<T, Access>::lookup(const Point2D &point) const {
+  auto found = this->map.find(point);
+  return found == this->map.end() ? nullptr : &found->second.value;
+}
 
-  std::vector<Point2D> deltas{DELTA_UP, DELTA_LEFT, DELTA_RIGHT, DELTA_DOWN};
-  if (!this->excludeDiagonals) {
-    deltas.insert(deltas.end(), {DELTA_UP_LEFT, DELTA_UP_RIGHT, DELTA_DOWN_LEFT,
-                                 DELTA_DOWN_RIGHT});
-  }
+template <typename T, typename Access>
+NeighborRange<Grid2D<T, Access>, T> Grid2D<T, Access>::neighbors(
+    const Point2D &point) const {
+  return this->neighbors(point, this->excludeDiagonals);
+}
 
-  for (const auto &delta : deltas) {
-    Point2D other = point + delta;
-    if (auto found = this->map.find(other); found != this->map.end()) {
-      adjacent[other] = found->second;
-    }
-  }
+template <typename T, typename Access>
+NeighborRange<Grid2D<T, Access>, T> Grid2D<T, Access>::neighbors(
+    const Point2D &point, bool excludeDiagonals) const {
+  return NeighborRange<Grid2D<T, Access>, T>(*this, point, excludeDiagonals);
+}
 
+template <typename T, typename Access>
+std::map<Point2D, T> Grid2D<T, Access>::pointsAdjacent(
+    const Point2D &point) const {
+  std::map<Point2D, T> adjacent{};
+  for (const auto &pair : this->neighbors(point)) {
+    adjacent[pair.first] = pair.second;
+  }
   return adjacent;
 }
 
-template <typename T>
-Grid2D<T> Grid2D<T>::subRegion(Range<int> xBounds, Range<int> yBounds) const {
-  Grid2D<T> newGrid{};
+template <typename T, typename Access>
+Grid2D<T, Access> Grid2D<T, Access>::subRegion(Range<int> xBounds,
+                                              Range<int> yBounds) const {
+  Grid2D<T, Access> newGrid{};
   newGrid.excludeDiagonals = this->excludeDiagonals;
 
   for (int y = yBounds.min; y <= yBounds.max; y++) {
@@ -139,8 +461,8 @@ Grid2D<T> Grid2D<T>::subRegion(Range<int> xBounds, Range<int> yBounds) const {
   return newGrid;
 }
 
-template <typename T>
-std::vector<T> Grid2D<T>::row(int y) const {
+template <typename T, typename Access>
+std::vector<T> Grid2D<T, Access>::row(int y) const {
   std::vector<T> vec{};
   for (int x = this->xBounds.min; x <= this->xBounds.max; x++) {
     vec.push_back(this->at({x, y}));
@@ -148,8 +470,8 @@ std::vector<T> Grid2D<T>::row(int y) const {
   return vec;
 }
 
-template <typename T>
-std::vector<T> Grid2D<T>::col(int x) const {
+template <typename T, typename Access>
+std::vector<T> Grid2D<T, Access>::col(int x) const {
   std::vector<T> vec{};
   for (int y = this->yBounds.min; y <= this->yBounds.max; y++) {
     vec.push_back(this->at({x, y}));
@@ -157,8 +479,69 @@ std::vector<T> Grid2D<T>::col(int x) const {
   return vec;
 }
 
-template <typename T>
-void Grid2D<T>::print() const {
+template <typename T, typename Access>
+LineView<Grid2D<T, Access>, T> Grid2D<T, Access>::rowView(int y) const {
+  return this->regionView(this->xBounds, this->yBounds).row(y);
+}
+
+template <typename T, typename Access>
+LineView<Grid2D<T, Access>, T> Grid2D<T, Access>::colView(int x) const {
+  return this->regionView(this->xBounds, this->yBounds).col(x);
+}
+
+template <typename T, typename Access>
+RegionView<Grid2D<T, Access>, T> Grid2D<T, Access>::regionView(
+    Range<int> xBounds, Range<int> yBounds) const {
+  return RegionView<Grid2D<T, Access>, T>(*this, xBounds, yBounds);
+}
+
+template <typename T, typename Access>
+RegionView<Grid2D<T, Access>, T> Grid2D<T, Access>::transposed() const {
+  return this->regionView(this->xBounds, this->yBounds).transposed();
+}
+
+template <typename T, typename Access>
+void Grid2D<T, Access>::enableHashing(bool wide) {
+  this->zobrist.emplace(wide);
+  for (auto cell : this->pending) {
+    cell->second.pending = false;
+  }
+  this->pending.clear();
+  for (const auto &pair : this->map) {
+    this->zobrist->toggle(pair.first.x, pair.first.y, pair.second.value);
+  }
+}
+
+template <typename T, typename Access>
+GridHash Grid2D<T, Access>::hash() const {
+  if (!this->zobrist) {
+    throw std::runtime_error("Grid2D::hash: hashing isn't enabled");
+  }
+  this->flushHash();
+  return this->zobrist->value();
+}
+
+template <typename T, typename Access>
+void Grid2D<T, Access>::flushHash() const {
+  for (auto cell : this->pending) {
+    this->zobrist->toggle(cell->first.x, cell->first.y, cell->second.value);
+    cell->second.pending = false;
+  }
+  this->pending.clear();
+}
+
+template <typename T, typename Access>
+void Grid2D<T, Access>::swap(Grid2D<T, Access> &other) {
+  std::swap(this->excludeDiagonals, other.excludeDiagonals);
+  std::swap(this->xBounds, other.xBounds);
+  std::swap(this->yBounds, other.yBounds);
+  this->map.swap(other.map);
+  this->zobrist.swap(other.zobrist);
+  this->pending.swap(other.pending);
+}
+
+template <typename T, typename Access>
+void Grid2D<T, Access>::print() const {
   int currentY = this->map.begin()->first.y;
   for (const auto &pair : this->map) {
     if (pair.first.y != currentY) {
@@ -166,9 +549,38 @@ void Grid2D<T>::print() const {
       currentY = pair.first.y;
     }
 
-    std::cout << pair.second;
+    std::cout << pair.second.value;
   }
   std::cout << std::endl;
 }
 
+template <typename T, typename Access>
+void swap(Grid2D<T, Access> &a, Grid2D<T, Access> &b) {
+  a.swap(b);
+}
+
+template <typename Grid, typename Line>
+Grid linesToGrid(const std::vector<Line> &lines) {
+  Grid grid{};
+  if constexpr (std::is_constructible_v<Grid, Range<int>, Range<int>>) {
+    // size grids that support it up front instead of growing cell by cell
+    size_t width = 0;
+    for (const Line &line : lines) {
+      width = std::max(width, (size_t)line.length());
+    }
+    if (width > 0) {
+      grid = Grid(Range<int>{0, (int)width - 1},
+                  Range<int>{0, (int)lines.size() - 1});
+    }
+  }
+
+  for (size_t y = 0; y < lines.size(); y++) {
+    const Line &line = lines[y];
+    for (size_t x = 0; x < line.length(); x++) {
+      grid[{(int)x, (int)y}] = line[x];
+    }
+  }
+  return grid;
+}
+
 #endif
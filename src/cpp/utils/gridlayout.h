@@ -0,0 +1,108 @@
+#ifndef GRIDLAYOUT_H
+#define GRIDLAYOUT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Storage layouts for DenseGrid2D. A layout is built for a width and height
+// and maps an (x, y) offset from the grid's origin to an index into its cell
+// vector; size() is how many cells that vector needs. These are called on
+// every cell access, so they're defined here where they can be inlined.
+
+// Plain row-major order. Rows are contiguous; walking a column strides by the
+// full width.
+class RowMajorLayout {
+ public:
+  RowMajorLayout() {}
+  RowMajorLayout(int width, int height) : width(width), height(height) {}
+
+  size_t size() const { return (size_t)this->width * this->height; }
+  size_t index(int x, int y) const {
+    return (size_t)y * this->width + x;
+  }
+
+ private:
+  int width = 0;
+  int height = 0;
+};
+
+// Row-major order of TILE_SIZE x TILE_SIZE tiles, each stored row-major. A
+// column walk only changes cache lines once per tile instead of every cell.
+template <int TILE_SIZE = 8>
+class TiledLayout {
+  static_assert(TILE_SIZE > 0 && (TILE_SIZE & (TILE_SIZE - 1)) == 0,
+                "TILE_SIZE has to be a power of two");
+
+ public:
+  TiledLayout() {}
+  TiledLayout(int width, int height)
+      : tilesPerRow((width + TILE_SIZE - 1) / TILE_SIZE),
+        tilesPerCol((height + TILE_SIZE - 1) / TILE_SIZE) {}
+
+  size_t size() const {
+    return (size_t)this->tilesPerRow * this->tilesPerCol * TILE_SIZE *
+           TILE_SIZE;
+  }
+  size_t index(int x, int y) const {
+    // offsets are never negative; unsigned lets / and % become shifts
+    size_t ux = x;
+    size_t uy = y;
+    size_t tile = (uy / TILE_SIZE) * this->tilesPerRow + ux / TILE_SIZE;
+    return tile * TILE_SIZE * TILE_SIZE + (uy % TILE_SIZE) * TILE_SIZE +
+           ux % TILE_SIZE;
+  }
+
+ private:
+  int tilesPerRow = 0;
+  int tilesPerCol = 0;
+};
+
+// Z-order: the bits of x and y are interleaved, so cells that are close in
+// either direction are close in memory at every scale. Each dimension is
+// padded to a power of two; whatever bits the longer one has left over go on
+// top.
+class MortonLayout {
+ public:
+  MortonLayout() {}
+  MortonLayout(int width, int height)
+      : xBits(bitsFor(width)), yBits(bitsFor(height)) {
+    this->commonBits = this->xBits < this->yBits ? this->xBits : this->yBits;
+    this->commonMask = ((uint64_t)1 << this->commonBits) - 1;
+  }
+
+  size_t size() const { return (size_t)1 << (this->xBits + this->yBits); }
+  size_t index(int x, int y) const {
+    uint64_t low = spreadBits(x & this->commonMask) |
+                   (spreadBits(y & this->commonMask) << 1);
+    // at most one of these is non-zero
+    uint64_t high = ((uint64_t)x >> this->commonBits) |
+                    ((uint64_t)y >> this->commonBits);
+    return low | (high << (2 * this->commonBits));
+  }
+
+ private:
+  int xBits = 0;
+  int yBits = 0;
+  int commonBits = 0;
+  uint64_t commonMask = 0;
+
+  static int bitsFor(int length) {
+    int bits = 0;
+    while (((int64_t)1 << bits) < length) {
+      bits++;
+    }
+    return bits;
+  }
+
+  // moves bit i of value to bit 2i
+  static uint64_t spreadBits(uint64_t value) {
+    value = (value | (value << 16)) & 0x0000ffff0000ffff;
+    value = (value | (value << 8)) & 0x00ff00ff00ff00ff;
+    value = (value | (value << 4)) & 0x0f0f0f0f0f0f0f0f;
+    value = (value | (value << 2)) & 0x3333333333333333;
+    value = (value | (value << 1)) & 0x5555555555555555;
+    return value;
+  }
+};
+
+#endif
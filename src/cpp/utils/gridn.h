@@ -0,0 +1,237 @@
+#ifndef GRIDN_H
+#define GRIDN_H
+
+#include <grid.h>
+#include <range.h>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Point with D integer coordinates; coords[0] is x, coords[1] is y and so on.
+// Points sort by their last axis first, so sorted points (and GridN
+// iteration) go x fastest, the same row-major order as Point2D.
+template <int D>
+class PointN {
+  static_assert(D > 0, "PointN needs at least one dimension");
+
+ public:
+  std::array<int, D> coords{};
+
+  PointN() {}
+  PointN(const std::array<int, D> &coords) : coords(coords) {}
+  // e.g. PointN<3>(x, y, z)
+  template <typename... Ints,
+            typename = std::enable_if_t<
+                sizeof...(Ints) == D &&
+                std::conjunction_v<std::is_convertible<Ints, int>...>>>
+  PointN(Ints... values) : coords{{(int)values...}} {}
+  // only for PointN<2>, to move between this and the 2D utilities
+  explicit PointN(const Point2D &point);
+  Point2D toPoint2D() const;
+
+  int &operator[](int axis) { return this->coords[axis]; }
+  const int &operator[](int axis) const { return this->coords[axis]; }
+  bool operator==(const PointN<D> &other) const;
+  bool operator!=(const PointN<D> &other) const;
+  bool operator<(const PointN<D> &other) const;
+  PointN<D> operator+(const PointN<D> &other) const;
+  PointN<D> operator-(const PointN<D> &other) const;
+  PointN<D> operator*(int multiplicand) const;
+
+  int manhattanDistanceFrom(const PointN<D> &other) const;
+};
+
+// 3^d
+constexpr int pow3(int d) { return d == 0 ? 1 : 3 * pow3(d - 1); }
+
+// Every offset with each axis in {-1, 0, 1} except all zeros, in the order
+// PointN sorts in. makeAllDeltas<2>() is ALL_DELTAS. These have to be defined
+// here to be usable at compile time.
+template <int D>
+constexpr std::array<std::array<int, D>, pow3(D) - 1> makeAllDeltas() {
+  std::array<std::array<int, D>, pow3(D) - 1> deltas{};
+  int count = 0;
+  for (int i = 0; i < pow3(D); i++) {
+    // i's base-3 digits, least significant first, are the offsets + 1
+    std::array<int, D> delta{};
+    bool isZero = true;
+    int rest = i;
+    for (int axis = 0; axis < D; axis++) {
+      delta[axis] = rest % 3 - 1;
+      isZero = isZero && delta[axis] == 0;
+      rest /= 3;
+    }
+    if (!isZero) {
+      deltas[count++] = delta;
+    }
+  }
+  return deltas;
+}
+
+// Same order as makeAllDeltas, keeping only the 2 * D offsets along one axis
+template <int D>
+constexpr std::array<std::array<int, D>, 2 * D> makeOrthogonalDeltas() {
+  std::array<std::array<int, D>, 2 * D> deltas{};
+  int count = 0;
+  for (const std::array<int, D> &delta : makeAllDeltas<D>()) {
+    int nonZero = 0;
+    for (int axis = 0; axis < D; axis++) {
+      nonZero += delta[axis] != 0;
+    }
+    if (nonZero == 1) {
+      deltas[count++] = delta;
+    }
+  }
+  return deltas;
+}
+
+template <int D>
+inline constexpr auto ALL_DELTAS_N = makeAllDeltas<D>();
+template <int D>
+inline constexpr auto ORTHOGONAL_DELTAS_N = makeOrthogonalDeltas<D>();
+
+// NeighborRange for GridN: yields (point, value) pairs for the 3^D - 1 (or
+// 2 * D, excluding diagonals) neighbors of a cell that the grid has, without
+// allocating
+template <typename Grid, typename T, int D>
+class NeighborRangeN {
+ public:
+  class iterator {
+   public:
+    using value_type = std::pair<PointN<D>, const T &>;
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    struct pointer {
+      value_type pair;
+      const value_type *operator->() const { return &this->pair; }
+    };
+
+    iterator(const NeighborRangeN *range, int index);
+
+    reference operator*() const { return {this->point, *this->value}; }
+    pointer operator->() const { return pointer{**this}; }
+    iterator &operator++();
+    bool operator==(const iterator &other) const;
+    bool operator!=(const iterator &other) const;
+
+   private:
+    const NeighborRangeN *range;
+    int index;
+    PointN<D> point{};
+    const T *value = nullptr;
+
+    // moves forward to the next neighbor the grid has
+    void settle();
+  };
+
+  NeighborRangeN(const Grid &grid, const PointN<D> &center,
+                 bool excludeDiagonals);
+
+  iterator begin() const;
+  iterator end() const;
+
+ private:
+  const Grid *grid;
+  PointN<D> center;
+  const std::array<int, D> *deltas;
+  int count;
+};
+
+// DenseGrid2D in D dimensions: cells live in one strided vector, every point
+// inside the bounds is a cell, and writing outside the bounds through
+// operator[] grows the storage geometrically. Iteration goes x fastest and
+// the last axis slowest.
+template <typename T, int D>
+class GridN {
+  static_assert(!std::is_same_v<T, bool>,
+                "std::vector<bool> can't hand out T&; use char instead");
+
+ public:
+  class iterator {
+   public:
+    using value_type = std::pair<PointN<D>, const T &>;
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    struct pointer {
+      value_type pair;
+      const value_type *operator->() const { return &this->pair; }
+    };
+
+    iterator(const GridN<T, D> *grid, size_t pos) : grid(grid), pos(pos) {}
+
+    reference operator*() const;
+    pointer operator->() const { return pointer{**this}; }
+    iterator &operator++();
+    iterator operator++(int);
+    bool operator==(const iterator &other) const;
+    bool operator!=(const iterator &other) const;
+
+   private:
+    const GridN<T, D> *grid;
+    size_t pos;
+  };
+
+  bool excludeDiagonals = false;
+  std::array<Range<int>, D> bounds{};
+
+  GridN();
+  GridN(bool excludeDiagonals);
+  // every cell in the bounds starts out as fill
+  GridN(const std::array<Range<int>, D> &bounds, const T &fill = T{});
+
+  T &operator[](const PointN<D> &point);
+  // no bounds checking or growth; use at() for a checked read
+  const T &operator[](const PointN<D> &point) const;
+  bool operator==(const GridN<T, D> &other) const;
+
+  const T &at(const PointN<D> &point) const;
+  iterator begin() const;
+  iterator end() const;
+  size_t size() const;
+
+  bool inBounds(const PointN<D> &point) const;
+  // the cell at point, or nullptr if it's out of bounds
+  const T *lookup(const PointN<D> &point) const;
+  // neighbors of point, diagonals included unless excludeDiagonals is set
+  NeighborRangeN<GridN<T, D>, T, D> neighbors(const PointN<D> &point) const;
+  NeighborRangeN<GridN<T, D>, T, D> neighbors(const PointN<D> &point,
+                                              bool excludeDiagonals) const;
+
+ private:
+  // storage covers origin[axis] to origin[axis] + extents[axis] - 1 along
+  // each axis, which can be more than the bounds once the grid has grown
+  std::array<int, D> origin{};
+  std::array<int, D> extents{};
+  std::vector<T> cells{};
+
+  size_t index(const PointN<D> &point) const;
+  // the point pos cells into the bounds, x fastest
+  PointN<D> pointAt(size_t pos) const;
+  void grow(const PointN<D> &point);
+};
+
+namespace std {
+template <int D>
+struct hash<PointN<D>> {
+  size_t operator()(const PointN<D> &point) const {
+    size_t hash = 0;
+    for (int coord : point.coords) {
+      hash = hash * 31 + std::hash<int>()(coord);
+    }
+    return hash;
+  }
+};
+}  // namespace std
+
+#include "gridn.tpp"
+
+#endif
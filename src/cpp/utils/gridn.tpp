@@ -0,0 +1,373 @@
+#ifndef GRIDN_TPP
+#define GRIDN_TPP
+
+#include <grid.h>
+#include <range.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "gridn.h"
+
+template <int D>
+PointN<D>::PointN(const Point2D &point) : coords{{point.x, point.y}} {
+  static_assert(D == 2, "only PointN<2> converts from Point2D");
+}
+
+template <int D>
+Point2D PointN<D>::toPoint2D() const {
+  static_assert(D == 2, "only PointN<2> converts to Point2D");
+  return Point2D(this->coords[0], this->coords[1]);
+}
+
+template <int D>
+bool PointN<D>::operator==(const PointN<D> &other) const {
+  return this->coords == other.coords;
+}
+
+template <int D>
+bool PointN<D>::operator!=(const PointN<D> &other) const {
+  return !(*this == other);
+}
+
+template <int D>
+bool PointN<D>::operator<(const PointN<D> &other) const {
+  for (int axis = D - 1; axis >= 0; axis--) {
+    if (this->coords[axis] != other.coords[axis]) {
+      return this->coords[axis] < other.coords[axis];
+    }
+  }
+  return false;
+}
+
+template <int D>
+PointN<D> PointN<D>::operator+(const PointN<D> &other) const {
+  PointN<D> sum;
+  for (int axis = 0; axis < D; axis++) {
+    sum.coords[axis] = this->coords[axis] + other.coords[axis];
+  }
+  return sum;
+}
+
+template <int D>
+PointN<D> PointN<D>::operator-(const PointN<D> &other) const {
+  PointN<D> difference;
+  for (int axis = 0; axis < D; axis++) {
+    difference.coords[axis] = this->coords[axis] - other.coords[axis];
+  }
+  return difference;
+}
+
+template <int D>
+PointN<D> PointN<D>::operator*(int multiplicand) const {
+  PointN<D> product;
+  for (int axis = 0; axis < D; axis++) {
+    product.coords[axis] = this->coords[axis] * multiplicand;
+  }
+  return product;
+}
+
+template <int D>
+int PointN<D>::manhattanDistanceFrom(const PointN<D> &other) const {
+  int distance = 0;
+  for (int axis = 0; axis < D; axis++) {
+    distance += std::abs(other.coords[axis] - this->coords[axis]);
+  }
+  return distance;
+}
+
+template <typename Grid, typename T, int D>
+NeighborRangeN<Grid, T, D>::iterator::iterator(const NeighborRangeN *range,
+                                               int index)
+    : range(range), index(index) {
+  this->settle();
+}
+
+template <typename Grid, typename T, int D>
+void NeighborRangeN<Grid, T, D>::iterator::settle() {
+  while (this->index < this->range->count) {
+    this->point = this->range->center +
+                  PointN<D>(this->range->deltas[this->index]);
+    this->value = this->range->grid->lookup(this->point);
+    if (this->value != nullptr) {
+      return;
+    }
+    this->index++;
+  }
+}
+
+template <typename Grid, typename T, int D>
+typename NeighborRangeN<Grid, T, D>::iterator &
+NeighborRangeN<Grid, T, D>::iterator::operator++() {
+  this->index++;
+  this->settle();
+  return *this;
+}
+
+template <typename Grid, typename T, int D>
+bool NeighborRangeN<Grid, T, D>::iterator::operator==(
+    const iterator &other) const {
+  return this->range == other.range && this->index == other.index;
+}
+
+template <typename Grid, typename T, int D>
+bool NeighborRangeN<Grid, T, D>::iterator::operator!=(
+    const iterator &other) const {
+  return !(*this == other);
+}
+
+template <typename Grid, typename T, int D>
+NeighborRangeN<Grid, T, D>::NeighborRangeN(const Grid &grid,
+                                           const PointN<D> &center,
+                                           bool excludeDiagonals)
+    : grid(&grid), center(center) {
+  if (excludeDiagonals) {
+    this->deltas = ORTHOGONAL_DELTAS_N<D>.data();
+    this->count = ORTHOGONAL_DELTAS_N<D>.size();
+  } else {
+    this->deltas = ALL_DELTAS_N<D>.data();
+    this->count = ALL_DELTAS_N<D>.size();
+  }
+}
+
+template <typename Grid, typename T, int D>
+typename NeighborRangeN<Grid, T, D>::iterator
+NeighborRangeN<Grid, T, D>::begin() const {
+  return iterator(this, 0);
+}
+
+template <typename Grid, typename T, int D>
+typename NeighborRangeN<Grid, T, D>::iterator NeighborRangeN<Grid, T, D>::end()
+    const {
+  return iterator(this, this->count);
+}
+
+template <typename T, int D>
+typename GridN<T, D>::iterator::reference GridN<T, D>::iterator::operator*()
+    const {
+  PointN<D> point = this->grid->pointAt(this->pos);
+  return {point, (*this->grid)[point]};
+}
+
+template <typename T, int D>
+typename GridN<T, D>::iterator &GridN<T, D>::iterator::operator++() {
+  this->pos++;
+  return *this;
+}
+
+template <typename T, int D>
+typename GridN<T, D>::iterator GridN<T, D>::iterator::operator++(int) {
+  iterator old = *this;
+  this->pos++;
+  return old;
+}
+
+template <typename T, int D>
+bool GridN<T, D>::iterator::operator==(const iterator &other) const {
+  return this->grid == other.grid && this->pos == other.pos;
+}
+
+template <typename T, int D>
+bool GridN<T, D>::iterator::operator!=(const iterator &other) const {
+  return !(*this == other);
+}
+
+template <typename T, int D>
+GridN<T, D>::GridN() {}
+
+template <typename T, int D>
+GridN<T, D>::GridN(bool excludeDiagonals) {
+  this->excludeDiagonals = excludeDiagonals;
+}
+
+template <typename T, int D>
+GridN<T, D>::GridN(const std::array<Range<int>, D> &bounds, const T &fill) {
+  this->bounds = bounds;
+  size_t size = 1;
+  for (int axis = 0; axis < D; axis++) {
+    this->origin[axis] = bounds[axis].min;
+    this->extents[axis] = bounds[axis].max - bounds[axis].min + 1;
+    size *= this->extents[axis];
+  }
+  this->cells.assign(size, fill);
+}
+
+template <typename T, int D>
+size_t GridN<T, D>::index(const PointN<D> &point) const {
+  // axis 0 is contiguous, the last axis has the biggest stride
+  size_t index = 0;
+  for (int axis = D - 1; axis >= 0; axis--) {
+    index = index * this->extents[axis] +
+            (point.coords[axis] - this->origin[axis]);
+  }
+  return index;
+}
+
+template <typename T, int D>
+PointN<D> GridN<T, D>::pointAt(size_t pos) const {
+  PointN<D> point;
+  for (int axis = 0; axis < D; axis++) {
+    size_t extent = this->bounds[axis].max - this->bounds[axis].min + 1;
+    point.coords[axis] = this->bounds[axis].min + pos % extent;
+    pos /= extent;
+  }
+  return point;
+}
+
+template <typename T, int D>
+void GridN<T, D>::grow(const PointN<D> &point) {
+  if (this->cells.empty()) {
+    // first cell
+    for (int axis = 0; axis < D; axis++) {
+      this->bounds[axis] = {point.coords[axis], point.coords[axis]};
+      this->origin[axis] = point.coords[axis];
+      this->extents[axis] = 1;
+    }
+    this->cells.assign(1, T{});
+    return;
+  }
+
+  std::array<Range<int>, D> newBounds;
+  bool fits = true;
+  for (int axis = 0; axis < D; axis++) {
+    int coord = point.coords[axis];
+    newBounds[axis] = {std::min(this->bounds[axis].min, coord),
+                       std::max(this->bounds[axis].max, coord)};
+    fits = fits && coord >= this->origin[axis] &&
+           coord < this->origin[axis] + this->extents[axis];
+  }
+
+  // if it's still inside the storage we just need to widen the bounds
+  if (fits) {
+    this->bounds = newBounds;
+    return;
+  }
+
+  // otherwise double the storage along whichever axes it overflowed
+  GridN<T, D> grown;
+  size_t size = 1;
+  for (int axis = 0; axis < D; axis++) {
+    int coord = point.coords[axis];
+    int min = this->origin[axis];
+    int max = this->origin[axis] + this->extents[axis] - 1;
+    if (coord < min) min = coord - this->extents[axis];
+    if (coord > max) max = coord + this->extents[axis];
+    grown.origin[axis] = min;
+    grown.extents[axis] = max - min + 1;
+    size *= grown.extents[axis];
+  }
+  grown.cells.resize(size);
+
+  for (size_t pos = 0; pos < this->size(); pos++) {
+    PointN<D> cell = this->pointAt(pos);
+    grown.cells[grown.index(cell)] = std::move(this->cells[this->index(cell)]);
+  }
+
+  this->origin = grown.origin;
+  this->extents = grown.extents;
+  this->cells = std::move(grown.cells);
+  this->bounds = newBounds;
+}
+
+template <typename T, int D>
+T &GridN<T, D>::operator[](const PointN<D> &point) {
+  if (this->cells.empty() || !this->inBounds(point)) {
+    this->grow(point);
+  }
+  return this->cells[this->index(point)];
+}
+
+template <typename T, int D>
+const T &GridN<T, D>::operator[](const PointN<D> &point) const {
+  return this->cells[this->index(point)];
+}
+
+template <typename T, int D>
+bool GridN<T, D>::operator==(const GridN<T, D> &other) const {
+  if (this->size() != other.size()) {
+    return false;
+  }
+  if (this->size() == 0) {
+    return true;
+  }
+  for (int axis = 0; axis < D; axis++) {
+    if (this->bounds[axis].min != other.bounds[axis].min ||
+        this->bounds[axis].max != other.bounds[axis].max) {
+      return false;
+    }
+  }
+  for (size_t pos = 0; pos < this->size(); pos++) {
+    PointN<D> point = this->pointAt(pos);
+    if (!((*this)[point] == other[point])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T, int D>
+const T &GridN<T, D>::at(const PointN<D> &point) const {
+  const T *cell = this->lookup(point);
+  if (cell == nullptr) {
+    throw std::out_of_range("GridN::at: point is out of bounds");
+  }
+  return *cell;
+}
+
+template <typename T, int D>
+typename GridN<T, D>::iterator GridN<T, D>::begin() const {
+  return iterator(this, 0);
+}
+
+template <typename T, int D>
+typename GridN<T, D>::iterator GridN<T, D>::end() const {
+  return iterator(this, this->size());
+}
+
+template <typename T, int D>
+size_t GridN<T, D>::size() const {
+  if (this->cells.empty()) {
+    return 0;
+  }
+  size_t size = 1;
+  for (const Range<int> &range : this->bounds) {
+    size *= range.max - range.min + 1;
+  }
+  return size;
+}
+
+template <typename T, int D>
+bool GridN<T, D>::inBounds(const PointN<D> &point) const {
+  for (int axis = 0; axis < D; axis++) {
+    if (!this->bounds[axis].contains(point.coords[axis])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T, int D>
+const T *GridN<T, D>::lookup(const PointN<D> &point) const {
+  if (this->cells.empty() || !this->inBounds(point)) {
+    return nullptr;
+  }
+  return &(*this)[point];
+}
+
+template <typename T, int D>
+NeighborRangeN<GridN<T, D>, T, D> GridN<T, D>::neighbors(
+    const PointN<D> &point) const {
+  return this->neighbors(point, this->excludeDiagonals);
+}
+
+template <typename T, int D>
+NeighborRangeN<GridN<T, D>, T, D> GridN<T, D>::neighbors(
+    const PointN<D> &point, bool excludeDiagonals) const {
+  return NeighborRangeN<GridN<T, D>, T, D>(*this, point, excludeDiagonals);
+}
+
+#endif
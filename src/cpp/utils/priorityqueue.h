@@ -0,0 +1,82 @@
+#ifndef PRIORITYQUEUE_H
+#define PRIORITYQUEUE_H
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Min-priority queues of (priority, value) pairs with a shared interface, so
+// GraphSearch can take any of them. pop() returns the pair with the smallest
+// priority; ties come out in any order. clear() keeps allocated memory around
+// for the next search.
+
+// Plain binary heap. Works for any priorities.
+template <typename T>
+class BinaryHeap {
+ public:
+  void push(long priority, const T &value);
+  std::pair<long, T> pop();
+  bool empty() const;
+  size_t size() const;
+  void clear();
+
+ private:
+  std::vector<std::pair<long, T>> heap{};
+
+  // reversed so the std heap algorithms build a min-heap
+  static bool greater(const std::pair<long, T> &a, const std::pair<long, T> &b);
+};
+
+// Dial's bucket queue: one bucket per priority in a ring that grows to span
+// the gap between the smallest and largest queued priority. Push and pop are
+// O(1) plus the empty buckets pop steps over, which is cheap when edge costs
+// are small integers. Priorities must be monotone: never push anything below
+// the last popped priority. Throws std::runtime_error if that's violated.
+template <typename T>
+class BucketQueue {
+ public:
+  void push(long priority, const T &value);
+  std::pair<long, T> pop();
+  bool empty() const;
+  size_t size() const;
+  void clear();
+
+ private:
+  std::vector<std::vector<T>> buckets{};
+  // buckets[cursor] holds priority current; the ring continues from there
+  // up to the highest queued priority
+  size_t cursor = 0;
+  long current = 0;
+  long highest = 0;
+  long floor = std::numeric_limits<long>::min();
+  size_t count = 0;
+
+  void grow(size_t minSize);
+};
+
+// Radix heap: bucket i holds priorities whose highest bit that differs from
+// the last popped priority is bit i - 1. Each value moves down at most 64
+// times, so operations are amortized O(log C) for priorities spanning C. Same
+// monotone requirement as BucketQueue, and priorities can't be negative.
+template <typename T>
+class RadixHeap {
+ public:
+  void push(long priority, const T &value);
+  std::pair<long, T> pop();
+  bool empty() const;
+  size_t size() const;
+  void clear();
+
+ private:
+  std::array<std::vector<std::pair<long, T>>, 65> buckets{};
+  long last = 0;
+  size_t count = 0;
+
+  size_t bucketFor(long priority) const;
+};
+
+#include "priorityqueue.tpp"
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef PRIORITYQUEUE_TPP
+#define PRIORITYQUEUE_TPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "priorityqueue.h"
+
+template <typename T>
+bool BinaryHeap<T>::greater(const std::pair<long, T> &a,
+                            const std::pair<long, T> &b) {
+  return a.first > b.first;
+}
+
+template <typename T>
+void BinaryHeap<T>::push(long priority, const T &value) {
+  this->heap.emplace_back(priority, value);
+  std::push_heap(this->heap.begin(), this->heap.end(), greater);
+}
+
+template <typename T>
+std::pair<long, T> BinaryHeap<T>::pop() {
+  std::pop_heap(this->heap.begin(), this->heap.end(), greater);
+  std::pair<long, T> top = std::move(this->heap.back());
+  this->heap.pop_back();
+  return top;
+}
+
+template <typename T>
+bool BinaryHeap<T>::empty() const {
+  return this->heap.empty();
+}
+
+template <typename T>
+size_t BinaryHeap<T>::size() const {
+  return this->heap.size();
+}
+
+template <typename T>
+void BinaryHeap<T>::clear() {
+  this->heap.clear();
+}
+
+template <typename T>
+void BucketQueue<T>::push(long priority, const T &value) {
+  if (priority < this->floor) {
+    throw std::runtime_error("BucketQueue: priority below the last popped one");
+  }
+
+  if (this->count == 0) {
+    // nothing queued, so the ring can start over at this priority
+    this->current = priority;
+    this->highest = priority;
+  } else if (priority < this->current) {
+    // nothing popped since the ring started; extend it downwards
+    if ((size_t)(this->highest - priority) >= this->buckets.size()) {
+      this->grow(this->highest - priority + 1);
+    }
+    size_t shift = this->current - priority;
+    this->cursor =
+        (this->cursor + this->buckets.size() - shift) % this->buckets.size();
+    this->current = priority;
+  }
+  this->highest = std::max(this->highest, priority);
+
+  size_t offset = priority - this->current;
+  if (offset >= this->buckets.size()) {
+    this->grow(offset + 1);
+  }
+  this->buckets[(this->cursor + offset) % this->buckets.size()].push_back(
+      value);
+  this->count++;
+}
+
+template <typename T>
+std::pair<long, T> BucketQueue<T>::pop() {
+  while (this->buckets[this->cursor].empty()) {
+    this->cursor = (this->cursor + 1) % this->buckets.size();
+    this->current++;
+  }
+
+  std::vector<T> &bucket = this->buckets[this->cursor];
+  std::pair<long, T> top{this->current, std::move(bucket.back())};
+  bucket.pop_back();
+  this->count--;
+  this->floor = this->current;
+  return top;
+}
+
+template <typename T>
+bool BucketQueue<T>::empty() const {
+  return this->count == 0;
+}
+
+template <typename T>
+size_t BucketQueue<T>::size() const {
+  return this->count;
+}
+
+template <typename T>
+void BucketQueue<T>::clear() {
+  for (std::vector<T> &bucket : this->buckets) {
+    bucket.clear();
+  }
+  this->cursor = 0;
+  this->count = 0;
+  this->floor = std::numeric_limits<long>::min();
+}
+
+template <typename T>
+void BucketQueue<T>::grow(size_t minSize) {
+  size_t newSize = std::max({minSize, this->buckets.size() * 2, (size_t)16});
+  std::vector<std::vector<T>> newBuckets(newSize);
+  // unroll the ring so the cursor's bucket lands at 0
+  for (size_t i = 0; i < this->buckets.size(); i++) {
+    newBuckets[i] = std::move(
+        this->buckets[(this->cursor + i) % this->buckets.size()]);
+  }
+  this->buckets = std::move(newBuckets);
+  this->cursor = 0;
+}
+
+template <typename T>
+size_t RadixHeap<T>::bucketFor(long priority) const {
+  uint64_t diff = (uint64_t)priority ^ (uint64_t)this->last;
+  return diff == 0 ? 0 : 64 - __builtin_clzll(diff);
+}
+
+template <typename T>
+void RadixHeap<T>::push(long priority, const T &value) {
+  if (priority < this->last) {
+    throw std::runtime_error("RadixHeap: priority below the last popped one");
+  }
+  this->buckets[this->bucketFor(priority)].emplace_back(priority, value);
+  this->count++;
+}
+
+template <typename T>
+std::pair<long, T> RadixHeap<T>::pop() {
+  if (this->buckets[0].empty()) {
+    // find the first non-empty bucket and spread it out relative to its
+    // minimum; everything in it lands in a lower bucket
+    size_t i = 1;
+    while (this->buckets[i].empty()) {
+      i++;
+    }
+
+    auto &bucket = this->buckets[i];
+    this->last = std::min_element(bucket.begin(), bucket.end(),
+                                  [](const auto &a, const auto &b) {
+                                    return a.first < b.first;
+                                  })
+                     ->first;
+    for (auto &entry : bucket) {
+      this->buckets[this->bucketFor(entry.first)].push_back(std::move(entry));
+    }
+    bucket.clear();
+  }
+
+  std::pair<long, T> top = std::move(this->buckets[0].back());
+  this->buckets[0].pop_back();
+  this->count--;
+  return top;
+}
+
+template <typename T>
+bool RadixHeap<T>::empty() const {
+  return this->count == 0;
+}
+
+template <typename T>
+size_t RadixHeap<T>::size() const {
+  return this->count;
+}
+
+template <typename T>
+void RadixHeap<T>::clear() {
+  for (auto &bucket : this->buckets) {
+    bucket.clear();
+  }
+  this->last = 0;
+  this->count = 0;
+}
+
+#endif
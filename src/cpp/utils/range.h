@@ -9,8 +9,8 @@ class Range {
   Number min;
   Number max;
 
-  Range() : min(0), max(0){};
-  Range(Number min, Number max) : min(min), max(max){};
+  constexpr Range() : min(0), max(0){};
+  constexpr Range(Number min, Number max) : min(min), max(max){};
 
   bool contains(Number num) const;
   bool contains(const Range<Number> &other) const;
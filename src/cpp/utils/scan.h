@@ -0,0 +1,47 @@
+#ifndef SCAN_H
+#define SCAN_H
+
+#include <array>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+// Compile-time format scanning, a regex-free replacement for simple fixed-shape
+// lines. A format is a constexpr char array made of literal text and fields:
+//
+//   {}   string_view running up to the next literal character (or line end)
+//   {N}  string_view of exactly N characters
+//   {d}  long; leading spaces are skipped, like scanf's %d
+//
+// The format is parsed while compiling and scan() is unrolled into straight
+// line matching code for it, so nothing is allocated at runtime:
+//
+//   constexpr char NODE_FORMAT[] = "{3} = ({3}, {3})";
+//   auto [from, left, right] = *scan<NODE_FORMAT>(line);
+
+struct ScanSegment {
+  enum Kind { LITERAL, FIELD_UNTIL, FIELD_FIXED, FIELD_INT };
+
+  Kind kind = LITERAL;
+  // LITERAL: offset into the format; FIELD_FIXED: unused
+  size_t start = 0;
+  // LITERAL: length of the literal run; FIELD_FIXED: field width
+  size_t len = 0;
+};
+
+template <const char *Format>
+constexpr size_t scanSegmentCount();
+
+template <const char *Format>
+constexpr std::array<ScanSegment, scanSegmentCount<Format>()> scanSegments();
+
+// Matches the whole line against Format and returns one tuple element per
+// field, or std::nullopt if the line doesn't fit. string_view fields point into
+// `line`.
+template <const char *Format>
+auto scan(std::string_view line);
+
+#include "scan.tpp"
+
+#endif
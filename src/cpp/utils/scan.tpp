@@ -0,0 +1,189 @@
+#ifndef SCAN_TPP
+#define SCAN_TPP
+
+#include <array>
+#include <charconv>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "scan.h"
+
+template <const char *Format>
+constexpr size_t scanFormatLength() {
+  size_t len = 0;
+  while (Format[len] != '\0') {
+    len++;
+  }
+  return len;
+}
+
+// Walks the format once, handing each segment to emit. Shared by the counting
+// and the filling pass so the two can't disagree.
+template <const char *Format, typename Emit>
+constexpr void forEachScanSegment(Emit emit) {
+  constexpr size_t length = scanFormatLength<Format>();
+
+  size_t i = 0;
+  while (i < length) {
+    if (Format[i] == '{') {
+      size_t close = i + 1;
+      while (close < length && Format[close] != '}') {
+        close++;
+      }
+      if (close == length) {
+        throw "unterminated field in scan format";
+      }
+
+      ScanSegment segment{};
+      if (close == i + 1) {
+        segment.kind = ScanSegment::FIELD_UNTIL;
+      } else if (close == i + 2 && Format[i + 1] == 'd') {
+        segment.kind = ScanSegment::FIELD_INT;
+      } else {
+        segment.kind = ScanSegment::FIELD_FIXED;
+        for (size_t j = i + 1; j < close; j++) {
+          if (Format[j] < '0' || Format[j] > '9') {
+            throw "bad field spec in scan format";
+          }
+          segment.len = segment.len * 10 + (Format[j] - '0');
+        }
+      }
+      emit(segment);
+      i = close + 1;
+    } else {
+      ScanSegment segment{ScanSegment::LITERAL, i, 0};
+      while (i < length && Format[i] != '{') {
+        i++;
+      }
+      segment.len = i - segment.start;
+      emit(segment);
+    }
+  }
+}
+
+template <const char *Format>
+constexpr size_t scanSegmentCount() {
+  size_t count = 0;
+  forEachScanSegment<Format>([&count](ScanSegment) { count++; });
+  return count;
+}
+
+template <const char *Format>
+constexpr std::array<ScanSegment, scanSegmentCount<Format>()> scanSegments() {
+  std::array<ScanSegment, scanSegmentCount<Format>()> segments{};
+  size_t idx = 0;
+  forEachScanSegment<Format>(
+      [&segments, &idx](ScanSegment segment) { segments[idx++] = segment; });
+
+  for (size_t i = 0; i + 1 < segments.size(); i++) {
+    if (segments[i].kind == ScanSegment::FIELD_UNTIL &&
+        segments[i + 1].kind != ScanSegment::LITERAL) {
+      throw "{} must be followed by literal text or the end of the format";
+    }
+  }
+
+  return segments;
+}
+
+template <const char *Format, size_t... Is>
+constexpr auto scanFieldSegmentIndices(std::index_sequence<Is...>) {
+  constexpr auto segments = scanSegments<Format>();
+  constexpr size_t fieldCount =
+      ((segments[Is].kind != ScanSegment::LITERAL ? 1 : 0) + ... + 0);
+
+  std::array<size_t, fieldCount> indices{};
+  size_t idx = 0;
+  for (size_t i = 0; i < segments.size(); i++) {
+    if (segments[i].kind != ScanSegment::LITERAL) {
+      indices[idx++] = i;
+    }
+  }
+  return indices;
+}
+
+template <ScanSegment::Kind Kind>
+using ScanFieldType =
+    std::conditional_t<Kind == ScanSegment::FIELD_INT, long, std::string_view>;
+
+template <const char *Format, size_t... Fields>
+auto scanResultType(std::index_sequence<Fields...>) {
+  constexpr auto segments = scanSegments<Format>();
+  constexpr auto fieldSegments = scanFieldSegmentIndices<Format>(
+      std::make_index_sequence<segments.size()>{});
+  return std::tuple<ScanFieldType<segments[fieldSegments[Fields]].kind>...>{};
+}
+
+template <const char *Format, size_t SegmentIdx, size_t FieldIdx,
+          typename Result>
+bool scanFrom(std::string_view &rest, Result &result) {
+  constexpr auto segments = scanSegments<Format>();
+
+  if constexpr (SegmentIdx == segments.size()) {
+    // the whole line has to be consumed
+    return rest.empty();
+  } else {
+    constexpr ScanSegment segment = segments[SegmentIdx];
+
+    if constexpr (segment.kind == ScanSegment::LITERAL) {
+      constexpr std::string_view literal(Format + segment.start, segment.len);
+      if (rest.substr(0, literal.size()) != literal) {
+        return false;
+      }
+      rest.remove_prefix(literal.size());
+      return scanFrom<Format, SegmentIdx + 1, FieldIdx>(rest, result);
+    } else {
+      if constexpr (segment.kind == ScanSegment::FIELD_FIXED) {
+        if (rest.size() < segment.len) {
+          return false;
+        }
+        std::get<FieldIdx>(result) = rest.substr(0, segment.len);
+        rest.remove_prefix(segment.len);
+      } else if constexpr (segment.kind == ScanSegment::FIELD_INT) {
+        size_t first = rest.find_first_not_of(' ');
+        if (first == std::string_view::npos) {
+          return false;
+        }
+        rest.remove_prefix(first);
+        auto [ptr, ec] = std::from_chars(rest.data(), rest.data() + rest.size(),
+                                         std::get<FieldIdx>(result));
+        if (ec != std::errc{}) {
+          return false;
+        }
+        rest.remove_prefix(ptr - rest.data());
+      } else if constexpr (SegmentIdx + 1 == segments.size()) {
+        // trailing {} takes the rest of the line
+        std::get<FieldIdx>(result) = rest;
+        rest.remove_prefix(rest.size());
+      } else {
+        constexpr char terminator = Format[segments[SegmentIdx + 1].start];
+        size_t end = rest.find(terminator);
+        if (end == std::string_view::npos) {
+          return false;
+        }
+        std::get<FieldIdx>(result) = rest.substr(0, end);
+        rest.remove_prefix(end);
+      }
+      return scanFrom<Format, SegmentIdx + 1, FieldIdx + 1>(rest, result);
+    }
+  }
+}
+
+template <const char *Format>
+auto scan(std::string_view line) {
+  constexpr auto segments = scanSegments<Format>();
+  constexpr auto fieldSegments = scanFieldSegmentIndices<Format>(
+      std::make_index_sequence<segments.size()>{});
+  using Result = decltype(scanResultType<Format>(
+      std::make_index_sequence<fieldSegments.size()>{}));
+
+  Result result{};
+  if (scanFrom<Format, 0, 0>(line, result)) {
+    return std::optional<Result>(result);
+  }
+  return std::optional<Result>();
+}
+
+#endif
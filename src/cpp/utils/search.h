@@ -0,0 +1,102 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <grid.h>
+#include <priorityqueue.h>
+#include <range.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Maps each point in a pair of bounds to a flat index, row-major. This is the
+// Indexer for searches whose states are plain points on a grid.
+class PointIndexer {
+ public:
+  PointIndexer(Range<int> xBounds, Range<int> yBounds)
+      : xMin(xBounds.min),
+        yMin(yBounds.min),
+        width(xBounds.max - xBounds.min + 1),
+        height(yBounds.max - yBounds.min + 1) {}
+
+  size_t operator()(const Point2D &point) const {
+    return (size_t)(point.y - this->yMin) * this->width +
+           (point.x - this->xMin);
+  }
+  size_t size() const { return (size_t)this->width * this->height; }
+
+ private:
+  int xMin;
+  int yMin;
+  int width;
+  int height;
+};
+
+// BFS, Dijkstra and A* over any state space that can be numbered densely.
+// The Indexer maps a State to a unique index below indexer.size(); a
+// PointIndexer covers plain points, and custom states such as (point,
+// direction) pairs just need their own indexer.
+//
+// Neighbor functions are called as neighbors(state, emit) and call
+// emit(next) or emit(next, cost) once per neighbor; BFS ignores costs.
+// Distances, visited marks and the frontier are all flat arrays that get
+// reused from one search to the next, so running many searches on the same
+// object (one per starting beam, say) doesn't allocate.
+//
+// Queue is the priority queue Dijkstra and A* use (see priorityqueue.h).
+// BucketQueue or RadixHeap beat the default BinaryHeap when costs are small
+// non-negative integers and the heuristic is consistent.
+template <typename State, typename Indexer,
+          template <typename> class Queue = BinaryHeap>
+class GraphSearch {
+ public:
+  static constexpr long UNREACHED = std::numeric_limits<long>::max();
+
+  GraphSearch(Indexer indexer);
+
+  // Every search starts from all sources at distance 0
+  template <typename NeighborFn>
+  void bfs(const std::vector<State> &sources, NeighborFn neighbors);
+  template <typename NeighborFn>
+  void dijkstra(const std::vector<State> &sources, NeighborFn neighbors);
+  // Stops at the first state isGoal accepts and returns its distance, or
+  // UNREACHED. heuristic(state) must never overestimate the remaining cost
+  template <typename NeighborFn, typename GoalFn, typename HeuristicFn>
+  long aStar(const std::vector<State> &sources, NeighborFn neighbors,
+             GoalFn isGoal, HeuristicFn heuristic);
+
+  // Results of the last search
+  bool reached(const State &state) const;
+  long distance(const State &state) const;
+  // states in the order their distances became final
+  const std::vector<State> &visited() const;
+
+ private:
+  struct QueueEntry {
+    long distance;
+    State state;
+  };
+
+  Indexer indexer;
+  std::vector<long> distances;
+  // a state's distance only counts if its stamp matches the current search,
+  // so starting a new search is O(1) instead of clearing every array
+  std::vector<uint32_t> stamps;
+  std::vector<uint32_t> doneStamps;
+  uint32_t stamp = 0;
+  std::vector<State> frontier{};
+  Queue<QueueEntry> queue{};
+  std::vector<State> order{};
+
+  void reset();
+  long currentDistance(size_t index) const;
+  bool isDone(size_t index) const;
+  template <typename NeighborFn, typename GoalFn, typename HeuristicFn>
+  long bestFirst(const std::vector<State> &sources, NeighborFn &neighbors,
+                 GoalFn &isGoal, HeuristicFn &heuristic);
+};
+
+#include "search.tpp"
+
+#endif
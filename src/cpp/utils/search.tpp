@@ -0,0 +1,148 @@
+#ifndef SEARCH_TPP
+#define SEARCH_TPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "search.h"
+
+template <typename State, typename Indexer, template <typename> class Queue>
+GraphSearch<State, Indexer, Queue>::GraphSearch(Indexer indexer)
+    : indexer(indexer),
+      distances(indexer.size()),
+      stamps(indexer.size(), 0),
+      doneStamps(indexer.size(), 0) {}
+
+template <typename State, typename Indexer, template <typename> class Queue>
+void GraphSearch<State, Indexer, Queue>::reset() {
+  this->stamp++;
+  if (this->stamp == 0) {
+    // wrapped around; old stamps could look current again
+    std::fill(this->stamps.begin(), this->stamps.end(), 0);
+    std::fill(this->doneStamps.begin(), this->doneStamps.end(), 0);
+    this->stamp = 1;
+  }
+  this->frontier.clear();
+  this->queue.clear();
+  this->order.clear();
+}
+
+template <typename State, typename Indexer, template <typename> class Queue>
+long GraphSearch<State, Indexer, Queue>::currentDistance(size_t index) const {
+  return this->stamps[index] == this->stamp ? this->distances[index]
+                                            : UNREACHED;
+}
+
+template <typename State, typename Indexer, template <typename> class Queue>
+bool GraphSearch<State, Indexer, Queue>::isDone(size_t index) const {
+  return this->doneStamps[index] == this->stamp;
+}
+
+template <typename State, typename Indexer, template <typename> class Queue>
+template <typename NeighborFn>
+void GraphSearch<State, Indexer, Queue>::bfs(const std::vector<State> &sources,
+                                             NeighborFn neighbors) {
+  this->reset();
+  for (const State &source : sources) {
+    size_t index = this->indexer(source);
+    if (this->stamps[index] != this->stamp) {
+      this->stamps[index] = this->stamp;
+      this->distances[index] = 0;
+      this->frontier.push_back(source);
+    }
+  }
+
+  // frontier is the queue; everything before head has been expanded
+  for (size_t head = 0; head < this->frontier.size(); head++) {
+    State state = this->frontier[head];
+    long nextDistance = this->distances[this->indexer(state)] + 1;
+    neighbors(state, [&](const State &next, long = 1) {
+      size_t index = this->indexer(next);
+      if (this->stamps[index] != this->stamp) {
+        this->stamps[index] = this->stamp;
+        this->distances[index] = nextDistance;
+        this->frontier.push_back(next);
+      }
+    });
+  }
+
+  this->order.swap(this->frontier);
+}
+
+template <typename State, typename Indexer, template <typename> class Queue>
+template <typename NeighborFn>
+void GraphSearch<State, Indexer, Queue>::dijkstra(
+    const std::vector<State> &sources, NeighborFn neighbors) {
+  auto never = [](const State &) { return false; };
+  auto zero = [](const State &) { return 0L; };
+  this->bestFirst(sources, neighbors, never, zero);
+}
+
+template <typename State, typename Indexer, template <typename> class Queue>
+template <typename NeighborFn, typename GoalFn, typename HeuristicFn>
+long GraphSearch<State, Indexer, Queue>::aStar(
+    const std::vector<State> &sources, NeighborFn neighbors, GoalFn isGoal,
+    HeuristicFn heuristic) {
+  return this->bestFirst(sources, neighbors, isGoal, heuristic);
+}
+
+template <typename State, typename Indexer, template <typename> class Queue>
+template <typename NeighborFn, typename GoalFn, typename HeuristicFn>
+long GraphSearch<State, Indexer, Queue>::bestFirst(
+    const std::vector<State> &sources, NeighborFn &neighbors, GoalFn &isGoal,
+    HeuristicFn &heuristic) {
+  this->reset();
+  for (const State &source : sources) {
+    size_t index = this->indexer(source);
+    this->stamps[index] = this->stamp;
+    this->distances[index] = 0;
+    this->queue.push(heuristic(source), {0, source});
+  }
+
+  while (!this->queue.empty()) {
+    QueueEntry entry = this->queue.pop().second;
+
+    size_t index = this->indexer(entry.state);
+    if (this->isDone(index) || entry.distance != this->distances[index]) {
+      // stale entry; a shorter path got here first
+      continue;
+    }
+    this->doneStamps[index] = this->stamp;
+    this->order.push_back(entry.state);
+
+    if (isGoal(entry.state)) {
+      return entry.distance;
+    }
+
+    neighbors(entry.state, [&](const State &next, long cost = 1) {
+      size_t nextIndex = this->indexer(next);
+      long nextDistance = entry.distance + cost;
+      if (nextDistance < this->currentDistance(nextIndex)) {
+        this->stamps[nextIndex] = this->stamp;
+        this->distances[nextIndex] = nextDistance;
+        this->queue.push(nextDistance + heuristic(next), {nextDistance, next});
+      }
+    });
+  }
+
+  return UNREACHED;
+}
+
+template <typename State, typename Indexer, template <typename> class Queue>
+bool GraphSearch<State, Indexer, Queue>::reached(const State &state) const {
+  return this->stamps[this->indexer(state)] == this->stamp;
+}
+
+template <typename State, typename Indexer, template <typename> class Queue>
+long GraphSearch<State, Indexer, Queue>::distance(const State &state) const {
+  return this->currentDistance(this->indexer(state));
+}
+
+template <typename State, typename Indexer, template <typename> class Queue>
+const std::vector<State> &GraphSearch<State, Indexer, Queue>::visited() const {
+  return this->order;
+}
+
+#endif
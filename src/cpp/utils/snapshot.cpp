@@ -0,0 +1,151 @@
+#include <file.h>
+#include <snapshot.h>
+#include <sys/stat.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+
+const char MAGIC[8] = {'A', 'O', 'C', 'S', 'N', 'A', 'P', '\0'};
+// bump whenever the header or how SnapshotWriter lays things out changes
+const uint32_t FORMAT_VERSION = 1;
+
+struct Header {
+  char magic[8];
+  uint32_t formatVersion;
+  uint32_t version;
+  uint64_t inputHash;
+  uint64_t payloadSize;
+};
+
+// splitmix64's finalizer: every input bit affects every output bit
+uint64_t mix(uint64_t value) {
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+  return value ^ (value >> 31);
+}
+
+}  // namespace
+
+void SnapshotWriter::write(const std::string& value) {
+  this->write((uint64_t)value.size());
+  this->writeBytes(value.data(), value.size());
+}
+
+void SnapshotWriter::writeBytes(const void* bytes, size_t length) {
+  this->buffer.append(static_cast<const char*>(bytes), length);
+}
+
+std::string_view SnapshotWriter::payload() const { return this->buffer; }
+
+SnapshotReader::SnapshotReader(std::string_view payload) : rest(payload) {}
+
+void SnapshotReader::read(std::string& value) {
+  size_t length = this->readCount();
+  if (length > this->rest.size()) {
+    throw std::runtime_error("SnapshotReader: string runs past the end");
+  }
+  value.assign(this->rest.substr(0, length));
+  this->rest.remove_prefix(length);
+}
+
+void SnapshotReader::readBytes(void* bytes, size_t length) {
+  if (length > this->rest.size()) {
+    throw std::runtime_error("SnapshotReader: read past the end");
+  }
+  std::memcpy(bytes, this->rest.data(), length);
+  this->rest.remove_prefix(length);
+}
+
+bool SnapshotReader::atEnd() const { return this->rest.empty(); }
+
+size_t SnapshotReader::readCount() {
+  uint64_t count;
+  this->read(count);
+  // every element takes at least a byte, so a bigger count is garbage; this
+  // keeps a bad snapshot from asking for a huge allocation
+  if (count > this->rest.size()) {
+    throw std::runtime_error("SnapshotReader: count runs past the end");
+  }
+  return count;
+}
+
+uint64_t contentHash(std::string_view bytes) {
+  uint64_t hash = mix(bytes.size());
+  size_t i = 0;
+  // eight bytes at a time, then whatever's left zero-padded
+  for (; i + 8 <= bytes.size(); i += 8) {
+    uint64_t word;
+    std::memcpy(&word, bytes.data() + i, 8);
+    hash = mix(hash ^ word);
+  }
+  if (i < bytes.size()) {
+    uint64_t word = 0;
+    std::memcpy(&word, bytes.data() + i, bytes.size() - i);
+    hash = mix(hash ^ word);
+  }
+  return hash;
+}
+
+std::optional<MappedInput> openSnapshot(const std::string& path,
+                                        uint32_t version, uint64_t inputHash) {
+  // not having a snapshot yet is normal; don't let MappedInput complain
+  struct stat info;
+  if (stat(path.c_str(), &info) == -1 ||
+      (size_t)info.st_size < sizeof(Header)) {
+    return std::nullopt;
+  }
+
+  MappedInput snapshot(path);
+  if (!snapshot.isOpen() || snapshot.size() < sizeof(Header)) {
+    return std::nullopt;
+  }
+
+  Header header;
+  std::memcpy(&header, snapshot.data(), sizeof(Header));
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header.formatVersion != FORMAT_VERSION || header.version != version ||
+      header.inputHash != inputHash ||
+      header.payloadSize != snapshot.size() - sizeof(Header)) {
+    return std::nullopt;
+  }
+  return snapshot;
+}
+
+std::string_view snapshotPayload(const MappedInput& snapshot) {
+  return snapshot.view().substr(sizeof(Header));
+}
+
+void saveSnapshot(const std::string& path, uint32_t version,
+                  uint64_t inputHash, std::string_view payload) {
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.formatVersion = FORMAT_VERSION;
+  header.version = version;
+  header.inputHash = inputHash;
+  header.payloadSize = payload.size();
+
+  std::string tempPath = path + ".tmp";
+  {
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    file.write(payload.data(), payload.size());
+    if (!file) {
+      std::cerr << "Could not write snapshot." << std::endl;
+      std::remove(tempPath.c_str());
+      return;
+    }
+  }
+  if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+    std::cerr << "Could not write snapshot." << std::endl;
+    std::remove(tempPath.c_str());
+  }
+}
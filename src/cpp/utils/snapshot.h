@@ -0,0 +1,114 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <densegrid.h>
+#include <file.h>
+#include <grid.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Binary snapshots of parsed inputs, so reruns on the same input can skip
+// text parsing. A snapshot is a fixed header followed by a payload:
+//
+//   magic "AOCSNAP\0", format version, caller's version (uint32 each),
+//   content hash of the input file, payload size (uint64 each)
+//
+// The payload is whatever SnapshotWriter produced. Trivially copyable values
+// are stored as their raw bytes, so snapshots are only meant to be read back
+// by the same build on the same machine; they're a cache, not an exchange
+// format. Containers and grids are stored as a uint64 count followed by their
+// elements. Any other type can be written and read by providing
+//   void writeSnapshot(SnapshotWriter& out, const T& value);
+//   void readSnapshot(SnapshotReader& in, T& value);
+// next to it, where argument-dependent lookup will find them.
+
+class SnapshotWriter {
+ public:
+  template <typename T>
+  void write(const T& value);
+  void write(const std::string& value);
+  template <typename T>
+  void write(const std::vector<T>& values);
+  template <typename T>
+  void write(const std::set<T>& values);
+  template <typename K, typename V>
+  void write(const std::map<K, V>& values);
+  template <typename A, typename B>
+  void write(const std::pair<A, B>& value);
+  template <typename T, typename Access>
+  void write(const Grid2D<T, Access>& grid);
+  template <typename T, typename Layout, typename Access>
+  void write(const DenseGrid2D<T, Layout, Access>& grid);
+
+  void writeBytes(const void* bytes, size_t length);
+  std::string_view payload() const;
+
+ private:
+  std::string buffer{};
+};
+
+// Reads back what a SnapshotWriter wrote, in the same order. Throws
+// std::runtime_error if it runs off the end of the payload.
+class SnapshotReader {
+ public:
+  SnapshotReader(std::string_view payload);
+
+  template <typename T>
+  void read(T& value);
+  void read(std::string& value);
+  template <typename T>
+  void read(std::vector<T>& values);
+  template <typename T>
+  void read(std::set<T>& values);
+  template <typename K, typename V>
+  void read(std::map<K, V>& values);
+  template <typename A, typename B>
+  void read(std::pair<A, B>& value);
+  template <typename T, typename Access>
+  void read(Grid2D<T, Access>& grid);
+  template <typename T, typename Layout, typename Access>
+  void read(DenseGrid2D<T, Layout, Access>& grid);
+
+  void readBytes(void* bytes, size_t length);
+  bool atEnd() const;
+
+ private:
+  std::string_view rest;
+
+  size_t readCount();
+};
+
+// 64-bit fingerprint of a file's contents
+uint64_t contentHash(std::string_view bytes);
+
+// Maps the snapshot at path, or returns nullopt if there's no snapshot there
+// or it was made from a different input, by a different format version or
+// with a different caller version.
+std::optional<MappedInput> openSnapshot(const std::string& path,
+                                        uint32_t version, uint64_t inputHash);
+// everything after the header of a snapshot openSnapshot accepted
+std::string_view snapshotPayload(const MappedInput& snapshot);
+// Writes the snapshot through a temporary file, so an interrupted run never
+// leaves a half-written one behind. Failures are reported but not fatal.
+void saveSnapshot(const std::string& path, uint32_t version,
+                  uint64_t inputHash, std::string_view payload);
+
+// Returns parse(input) for the file, where input is its MappedInput. The
+// result is saved to filename + ".snap" and later runs on the same contents
+// load it from there instead of parsing. Bump version whenever T or the
+// parser changes, since old snapshots can't tell. T must own all its data;
+// nothing it holds may point into the MappedInput.
+template <typename T, typename ParseFn>
+T cachedParse(const std::string& filename, uint32_t version, ParseFn parse);
+
+#include "snapshot.tpp"
+
+#endif
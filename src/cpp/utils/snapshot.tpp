@@ -0,0 +1,235 @@
+#ifndef SNAPSHOT_TPP
+#define SNAPSHOT_TPP
+
+#include <densegrid.h>
+#include <file.h>
+#include <grid.h>
+#include <gridlayout.h>
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "snapshot.h"
+
+template <typename T>
+void SnapshotWriter::write(const T& value) {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    static_assert(!std::is_pointer_v<T> &&
+                      !std::is_same_v<T, std::string_view>,
+                  "pointers don't survive a snapshot; store what they point "
+                  "to instead");
+    this->writeBytes(&value, sizeof(T));
+  } else {
+    // anything else brings its own writeSnapshot, found by ADL
+    writeSnapshot(*this, value);
+  }
+}
+
+template <typename T>
+void SnapshotWriter::write(const std::vector<T>& values) {
+  this->write((uint64_t)values.size());
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    this->writeBytes(values.data(), values.size() * sizeof(T));
+  } else {
+    for (const T& value : values) {
+      this->write(value);
+    }
+  }
+}
+
+template <typename T>
+void SnapshotWriter::write(const std::set<T>& values) {
+  this->write((uint64_t)values.size());
+  for (const T& value : values) {
+    this->write(value);
+  }
+}
+
+template <typename K, typename V>
+void SnapshotWriter::write(const std::map<K, V>& values) {
+  this->write((uint64_t)values.size());
+  for (const auto& pair : values) {
+    this->write(pair.first);
+    this->write(pair.second);
+  }
+}
+
+template <typename A, typename B>
+void SnapshotWriter::write(const std::pair<A, B>& value) {
+  this->write(value.first);
+  this->write(value.second);
+}
+
+template <typename T, typename Access>
+void SnapshotWriter::write(const Grid2D<T, Access>& grid) {
+  this->write(grid.excludeDiagonals);
+  this->write(grid.xBounds);
+  this->write(grid.yBounds);
+  this->write((uint64_t)grid.size());
+  for (const auto& pair : grid) {
+    this->write(pair.first);
+    this->write(pair.second);
+  }
+}
+
+template <typename T, typename Layout, typename Access>
+void SnapshotWriter::write(const DenseGrid2D<T, Layout, Access>& grid) {
+  this->write(grid.excludeDiagonals);
+  this->write((uint64_t)grid.size());
+  if (grid.size() == 0) {
+    return;
+  }
+
+  this->write(grid.xBounds);
+  this->write(grid.yBounds);
+  // cells within the bounds, row-major whatever the layout
+  for (int y = grid.yBounds.min; y <= grid.yBounds.max; y++) {
+    if constexpr (std::is_trivially_copyable_v<T> &&
+                  std::is_same_v<Layout, RowMajorLayout>) {
+      int width = grid.xBounds.max - grid.xBounds.min + 1;
+      this->writeBytes(&grid[{grid.xBounds.min, y}], width * sizeof(T));
+    } else {
+      for (int x = grid.xBounds.min; x <= grid.xBounds.max; x++) {
+        this->write(grid[{x, y}]);
+      }
+    }
+  }
+}
+
+template <typename T>
+void SnapshotReader::read(T& value) {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    static_assert(!std::is_pointer_v<T> &&
+                      !std::is_same_v<T, std::string_view>,
+                  "pointers don't survive a snapshot; store what they point "
+                  "to instead");
+    this->readBytes(&value, sizeof(T));
+  } else {
+    readSnapshot(*this, value);
+  }
+}
+
+template <typename T>
+void SnapshotReader::read(std::vector<T>& values) {
+  values.resize(this->readCount());
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    this->readBytes(values.data(), values.size() * sizeof(T));
+  } else {
+    for (T& value : values) {
+      this->read(value);
+    }
+  }
+}
+
+template <typename T>
+void SnapshotReader::read(std::set<T>& values) {
+  values.clear();
+  size_t count = this->readCount();
+  for (size_t i = 0; i < count; i++) {
+    T value{};
+    this->read(value);
+    // written in order, so every value goes on the end
+    values.emplace_hint(values.end(), std::move(value));
+  }
+}
+
+template <typename K, typename V>
+void SnapshotReader::read(std::map<K, V>& values) {
+  values.clear();
+  size_t count = this->readCount();
+  for (size_t i = 0; i < count; i++) {
+    K key{};
+    V value{};
+    this->read(key);
+    this->read(value);
+    values.emplace_hint(values.end(), std::move(key), std::move(value));
+  }
+}
+
+template <typename A, typename B>
+void SnapshotReader::read(std::pair<A, B>& value) {
+  this->read(value.first);
+  this->read(value.second);
+}
+
+template <typename T, typename Access>
+void SnapshotReader::read(Grid2D<T, Access>& grid) {
+  grid = Grid2D<T, Access>{};
+  this->read(grid.excludeDiagonals);
+  this->read(grid.xBounds);
+  this->read(grid.yBounds);
+  size_t count = this->readCount();
+  for (size_t i = 0; i < count; i++) {
+    Point2D point;
+    T value{};
+    this->read(point);
+    this->read(value);
+    grid.map.emplace_hint(grid.map.end(), point,
+                          typename Grid2D<T, Access>::Cell{std::move(value)});
+  }
+}
+
+template <typename T, typename Layout, typename Access>
+void SnapshotReader::read(DenseGrid2D<T, Layout, Access>& grid) {
+  bool excludeDiagonals;
+  this->read(excludeDiagonals);
+  if (this->readCount() == 0) {
+    grid = DenseGrid2D<T, Layout, Access>(excludeDiagonals);
+    return;
+  }
+
+  Range<int> xBounds;
+  Range<int> yBounds;
+  this->read(xBounds);
+  this->read(yBounds);
+  grid = DenseGrid2D<T, Layout, Access>(xBounds, yBounds);
+  grid.excludeDiagonals = excludeDiagonals;
+  if constexpr (std::is_trivially_copyable_v<T> &&
+                std::is_same_v<Layout, RowMajorLayout>) {
+    // a freshly built row-major grid is exactly the bounds, in order
+    this->readBytes(grid.cells.data(), grid.cells.size() * sizeof(T));
+  } else {
+    for (int y = yBounds.min; y <= yBounds.max; y++) {
+      for (int x = xBounds.min; x <= xBounds.max; x++) {
+        this->read(grid.cells[grid.index(x, y)]);
+      }
+    }
+  }
+}
+
+template <typename T, typename ParseFn>
+T cachedParse(const std::string& filename, uint32_t version, ParseFn parse) {
+  MappedInput input(filename);
+  uint64_t inputHash = contentHash(input.view());
+  std::string path = filename + ".snap";
+
+  if (auto snapshot = openSnapshot(path, version, inputHash)) {
+    try {
+      SnapshotReader reader(snapshotPayload(*snapshot));
+      T value{};
+      reader.read(value);
+      if (reader.atEnd()) {
+        return value;
+      }
+    } catch (const std::runtime_error&) {
+      // same header but a different layout; version wasn't bumped
+    }
+    std::cerr << "Ignoring unreadable snapshot " << path << std::endl;
+  }
+
+  T value = parse(input);
+  SnapshotWriter writer;
+  writer.write(value);
+  saveSnapshot(path, version, inputHash, writer.payload());
+  return value;
+}
+
+#endif
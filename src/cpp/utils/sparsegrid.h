@@ -0,0 +1,104 @@
+#ifndef SPARSEGRID_H
+#define SPARSEGRID_H
+
+#include <grid.h>
+#include <range.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <utility>
+#include <vector>
+
+// Grid2D for sparse or unbounded coordinates. Points are packed into a 64-bit
+// key and stored in an open-addressing (linear probing) hash table, so only
+// cells that have been written take up space. Negative coordinates are fine,
+// except for {INT_MIN, INT_MIN}, which marks empty slots. Bounds grow with
+// every write just like Grid2D.
+//
+// Iteration order is unspecified, so unlike Grid2D there is no rbegin(). Cells
+// that were never written read as T{} in row(), col() and print().
+template <typename T>
+class SparseGrid2D {
+ public:
+  // Iterates written cells in table order, yielding (point, value) pairs
+  class iterator {
+   public:
+    using value_type = std::pair<Point2D, const T &>;
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    struct pointer {
+      value_type pair;
+      const value_type *operator->() const { return &this->pair; }
+    };
+
+    iterator(const SparseGrid2D<T> *grid, size_t slot);
+
+    reference operator*() const;
+    pointer operator->() const { return pointer{**this}; }
+    iterator &operator++();
+    iterator operator++(int);
+    bool operator==(const iterator &other) const;
+    bool operator!=(const iterator &other) const;
+
+   private:
+    const SparseGrid2D<T> *grid;
+    size_t slot;
+
+    void skipEmpty();
+  };
+
+  bool excludeDiagonals = false;
+  Range<int> xBounds{0, 0};
+  Range<int> yBounds{0, 0};
+
+  SparseGrid2D();
+  SparseGrid2D(bool excludeDiagonals);
+
+  T &operator[](const Point2D &point);
+  bool operator==(const SparseGrid2D<T> &other) const;
+
+  const T &at(const Point2D &point) const;
+  iterator find(const Point2D &point) const;
+  iterator begin() const;
+  iterator end() const;
+  size_t size() const;
+  // make room for count cells without rehashing
+  void reserve(size_t count);
+
+  bool inBounds(const Point2D &point) const;
+  // the cell at point, or nullptr if it was never written
+  const T *lookup(const Point2D &point) const;
+  // neighbors of point, diagonals included unless excludeDiagonals is set
+  NeighborRange<SparseGrid2D<T>, T> neighbors(const Point2D &point) const;
+  NeighborRange<SparseGrid2D<T>, T> neighbors(const Point2D &point,
+                                              bool excludeDiagonals) const;
+  std::map<Point2D, T> pointsAdjacent(const Point2D &point) const;
+  SparseGrid2D<T> subRegion(Range<int> xBounds, Range<int> yBounds) const;
+  std::vector<T> row(int y) const;
+  std::vector<T> col(int x) const;
+  void print() const;
+
+ private:
+  struct Slot {
+    uint64_t key;
+    T value;
+  };
+
+  static constexpr uint64_t EMPTY_KEY = 0x8000000080000000;
+
+  std::vector<Slot> slots{};
+  size_t count = 0;
+  // hash(key) >> shift is the home slot; capacity is 1 << (64 - shift)
+  int shift = 64;
+
+  size_t findSlot(uint64_t key) const;
+  void rehash(size_t capacity);
+};
+
+#include "sparsegrid.tpp"
+
+#endif
@@ -0,0 +1,268 @@
+#ifndef SPARSEGRID_TPP
+#define SPARSEGRID_TPP
+
+#include <grid.h>
+#include <range.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "sparsegrid.h"
+
+template <typename T>
+SparseGrid2D<T>::iterator::iterator(const SparseGrid2D<T> *grid, size_t slot)
+    : grid(grid), slot(slot) {
+  this->skipEmpty();
+}
+
+template <typename T>
+void SparseGrid2D<T>::iterator::skipEmpty() {
+  while (this->slot < this->grid->slots.size() &&
+         this->grid->slots[this->slot].key == EMPTY_KEY) {
+    this->slot++;
+  }
+}
+
+template <typename T>
+typename SparseGrid2D<T>::iterator::reference
+SparseGrid2D<T>::iterator::operator*() const {
+  const Slot &slot = this->grid->slots[this->slot];
+  return {Point2D::unpack(slot.key), slot.value};
+}
+
+template <typename T>
+typename SparseGrid2D<T>::iterator &SparseGrid2D<T>::iterator::operator++() {
+  this->slot++;
+  this->skipEmpty();
+  return *this;
+}
+
+template <typename T>
+typename SparseGrid2D<T>::iterator SparseGrid2D<T>::iterator::operator++(int) {
+  iterator old = *this;
+  ++*this;
+  return old;
+}
+
+template <typename T>
+bool SparseGrid2D<T>::iterator::operator==(const iterator &other) const {
+  return this->grid == other.grid && this->slot == other.slot;
+}
+
+template <typename T>
+bool SparseGrid2D<T>::iterator::operator!=(const iterator &other) const {
+  return !(*this == other);
+}
+
+template <typename T>
+SparseGrid2D<T>::SparseGrid2D() {}
+
+template <typename T>
+SparseGrid2D<T>::SparseGrid2D(bool excludeDiagonals) {
+  this->excludeDiagonals = excludeDiagonals;
+}
+
+// Returns the slot holding key, or the empty slot where it would go
+template <typename T>
+size_t SparseGrid2D<T>::findSlot(uint64_t key) const {
+  size_t mask = this->slots.size() - 1;
+  // fibonacci hashing spreads neighboring points across the table
+  size_t slot = (key * 0x9e3779b97f4a7c15) >> this->shift;
+  while (this->slots[slot].key != key && this->slots[slot].key != EMPTY_KEY) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+template <typename T>
+void SparseGrid2D<T>::rehash(size_t capacity) {
+  int bits = 1;
+  while (((size_t)1 << bits) < capacity) {
+    bits++;
+  }
+
+  std::vector<Slot> old = std::move(this->slots);
+  this->slots.assign((size_t)1 << bits, Slot{EMPTY_KEY, T{}});
+  this->shift = 64 - bits;
+  for (Slot &slot : old) {
+    if (slot.key != EMPTY_KEY) {
+      this->slots[this->findSlot(slot.key)] = std::move(slot);
+    }
+  }
+}
+
+template <typename T>
+void SparseGrid2D<T>::reserve(size_t count) {
+  // keep the load factor at or below 1/2
+  if (count * 2 > this->slots.size()) {
+    this->rehash(count * 2);
+  }
+}
+
+template <typename T>
+T &SparseGrid2D<T>::operator[](const Point2D &point) {
+  if (this->count == 0) {
+    this->xBounds = {point.x, point.x};
+    this->yBounds = {point.y, point.y};
+  } else {
+    this->xBounds.min = std::min(this->xBounds.min, point.x);
+    this->xBounds.max = std::max(this->xBounds.max, point.x);
+    this->yBounds.min = std::min(this->yBounds.min, point.y);
+    this->yBounds.max = std::max(this->yBounds.max, point.y);
+  }
+
+  this->reserve(std::max(this->count + 1, (size_t)8));
+
+  uint64_t key = point.pack();
+  Slot &slot = this->slots[this->findSlot(key)];
+  if (slot.key == EMPTY_KEY) {
+    slot.key = key;
+    this->count++;
+  }
+  return slot.value;
+}
+
+template <typename T>
+bool SparseGrid2D<T>::operator==(const SparseGrid2D<T> &other) const {
+  if (this->size() != other.size()) {
+    return false;
+  }
+
+  for (const auto &pair : *this) {
+    auto it = other.find(pair.first);
+    if (it == other.end()) {
+      return false;
+    }
+
+    if (it->second != pair.second) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template <typename T>
+const T &SparseGrid2D<T>::at(const Point2D &point) const {
+  auto it = this->find(point);
+  if (it == this->end()) {
+    throw std::out_of_range("SparseGrid2D::at: no cell at point");
+  }
+  return it->second;
+}
+
+template <typename T>
+typename SparseGrid2D<T>::iterator SparseGrid2D<T>::find(
+    const Point2D &point) const {
+  if (this->count == 0) {
+    return this->end();
+  }
+  size_t slot = this->findSlot(point.pack());
+  if (this->slots[slot].key == EMPTY_KEY) {
+    return this->end();
+  }
+  return iterator(this, slot);
+}
+
+template <typename T>
+typename SparseGrid2D<T>::iterator SparseGrid2D<T>::begin() const {
+  return iterator(this, 0);
+}
+
+template <typename T>
+typename SparseGrid2D<T>::iterator SparseGrid2D<T>::end() const {
+  return iterator(this, this->slots.size());
+}
+
+template <typename T>
+size_t SparseGrid2D<T>::size() const {
+  return this->count;
+}
+
+template <typename T>
+bool SparseGrid2D<T>::inBounds(const Point2D &point) const {
+  return this->xBounds.contains(point.x) && this->yBounds.contains(point.y);
+}
+
+template <typename T>
+const T *SparseGrid2D<T>::lookup(const Point2D &point) const {
+  if (this->count == 0) {
+    return nullptr;
+  }
+  const Slot &slot = this->slots[this->findSlot(point.pack())];
+  return slot.key == EMPTY_KEY ? nullptr : &slot.value;
+}
+
+template <typename T>
+NeighborRange<SparseGrid2D<T>, T> SparseGrid2D<T>::neighbors(
+    const Point2D &point) const {
+  return this->neighbors(point, this->excludeDiagonals);
+}
+
+template <typename T>
+NeighborRange<SparseGrid2D<T>, T> SparseGrid2D<T>::neighbors(
+    const Point2D &point, bool excludeDiagonals) const {
+  return NeighborRange<SparseGrid2D<T>, T>(*this, point, excludeDiagonals);
+}
+
+template <typename T>
+std::map<Point2D, T> SparseGrid2D<T>::pointsAdjacent(
+    const Point2D &point) const {
+  std::map<Point2D, T> adjacent{};
+  for (const auto &pair : this->neighbors(point)) {
+    adjacent[pair.first] = pair.second;
+  }
+  return adjacent;
+}
+
+template <typename T>
+SparseGrid2D<T> SparseGrid2D<T>::subRegion(Range<int> xBounds,
+                                           Range<int> yBounds) const {
+  SparseGrid2D<T> newGrid{};
+  newGrid.excludeDiagonals = this->excludeDiagonals;
+
+  for (const auto &pair : *this) {
+    if (xBounds.contains(pair.first.x) && yBounds.contains(pair.first.y)) {
+      newGrid[pair.first] = pair.second;
+    }
+  }
+
+  return newGrid;
+}
+
+template <typename T>
+std::vector<T> SparseGrid2D<T>::row(int y) const {
+  std::vector<T> vec{};
+  for (int x = this->xBounds.min; x <= this->xBounds.max; x++) {
+    auto it = this->find({x, y});
+    vec.push_back(it == this->end() ? T{} : it->second);
+  }
+  return vec;
+}
+
+template <typename T>
+std::vector<T> SparseGrid2D<T>::col(int x) const {
+  std::vector<T> vec{};
+  for (int y = this->yBounds.min; y <= this->yBounds.max; y++) {
+    auto it = this->find({x, y});
+    vec.push_back(it == this->end() ? T{} : it->second);
+  }
+  return vec;
+}
+
+template <typename T>
+void SparseGrid2D<T>::print() const {
+  for (int y = this->yBounds.min; y <= this->yBounds.max; y++) {
+    for (const auto &cell : this->row(y)) {
+      std::cout << cell;
+    }
+    std::cout << std::endl;
+  }
+}
+
+#endif
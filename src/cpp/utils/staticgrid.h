@@ -0,0 +1,144 @@
+#ifndef STATICGRID_H
+#define STATICGRID_H
+
+#include <densegrid.h>
+#include <grid.h>
+#include <range.h>
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// DenseGrid2D whose size is part of its type: W x H cells covering (0, 0) to
+// (W - 1, H - 1), held in a std::array. All the index math is against
+// constants, so the compiler can turn it into shifts and adds and unroll
+// anything that walks a row or column, and the grid lives wherever its owner
+// does (on the stack, for a local). It can't grow; writing outside the bounds
+// is the same mistake reading outside them is, and Access decides whether
+// either gets checked.
+//
+// Most inputs come in a handful of sizes; see withLinesGrid() below for
+// picking one at runtime.
+template <typename T, int W, int H, typename Access = DefaultAccess>
+class StaticGrid2D {
+  static_assert(W > 0 && H > 0, "StaticGrid2D needs at least one cell");
+
+ public:
+  class iterator {
+   public:
+    using value_type = std::pair<Point2D, const T &>;
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    struct pointer {
+      value_type pair;
+      const value_type *operator->() const { return &this->pair; }
+    };
+
+    iterator(const StaticGrid2D<T, W, H, Access> *grid, long pos, int step)
+        : grid(grid), pos(pos), step(step) {}
+
+    reference operator*() const;
+    pointer operator->() const { return pointer{**this}; }
+    iterator &operator++();
+    iterator operator++(int);
+    bool operator==(const iterator &other) const;
+    bool operator!=(const iterator &other) const;
+
+   private:
+    const StaticGrid2D<T, W, H, Access> *grid;
+    long pos;
+    int step;
+  };
+
+  static constexpr int WIDTH = W;
+  static constexpr int HEIGHT = H;
+  static constexpr Range<int> xBounds{0, W - 1};
+  static constexpr Range<int> yBounds{0, H - 1};
+
+  bool excludeDiagonals = false;
+
+  StaticGrid2D();
+  // every cell starts out as fill
+  StaticGrid2D(const T &fill);
+
+  T &operator[](const Point2D &point);
+  const T &operator[](const Point2D &point) const;
+  bool operator==(const StaticGrid2D<T, W, H, Access> &other) const;
+
+  const T &at(const Point2D &point) const;
+  iterator find(const Point2D &point) const;
+  iterator begin() const;
+  iterator rbegin() const;
+  iterator end() const;
+  iterator rend() const;
+  static constexpr size_t size() { return (size_t)W * H; }
+
+  bool inBounds(const Point2D &point) const;
+  // the cell at point, or nullptr if it's out of bounds
+  const T *lookup(const Point2D &point) const;
+  // neighbors of point, diagonals included unless excludeDiagonals is set
+  NeighborRange<StaticGrid2D<T, W, H, Access>, T> neighbors(
+      const Point2D &point) const;
+  NeighborRange<StaticGrid2D<T, W, H, Access>, T> neighbors(
+      const Point2D &point, bool excludeDiagonals) const;
+  // same as neighbors() without bounds checks; point can't be on the edge
+  NeighborRange<StaticGrid2D<T, W, H, Access>, T, false> interiorNeighbors(
+      const Point2D &point) const;
+  std::map<Point2D, T> pointsAdjacent(const Point2D &point) const;
+  // regions aren't sized at compile time, so this is a DenseGrid2D
+  DenseGrid2D<T, RowMajorLayout, Access> subRegion(Range<int> xBounds,
+                                                   Range<int> yBounds) const;
+  // fixed-size copies, so unlike the other grids these don't allocate
+  std::array<T, W> row(int y) const;
+  std::array<T, H> col(int x) const;
+  // non-owning versions of the above; see LineView and RegionView
+  LineView<StaticGrid2D<T, W, H, Access>, T> rowView(int y) const;
+  LineView<StaticGrid2D<T, W, H, Access>, T> colView(int x) const;
+  RegionView<StaticGrid2D<T, W, H, Access>, T> regionView(
+      Range<int> xBounds, Range<int> yBounds) const;
+  RegionView<StaticGrid2D<T, W, H, Access>, T> transposed() const;
+  void print() const;
+
+  // O(W * H), since the cells are stored inline
+  void swap(StaticGrid2D<T, W, H, Access> &other);
+
+ private:
+  std::array<T, (size_t)W * H> cells{};
+
+  static size_t index(const Point2D &point);
+  static Point2D pointAt(long pos);
+};
+
+template <typename T, int W, int H, typename Access>
+void swap(StaticGrid2D<T, W, H, Access> &a, StaticGrid2D<T, W, H, Access> &b);
+
+// A list of sizes for withLinesGrid(), e.g.
+// GridSizes<GridSize<140, 140>, GridSize<110, 110>>
+template <int W, int H>
+struct GridSize {};
+template <typename... Sizes>
+struct GridSizes {};
+
+// The sizes real inputs have come in
+using CommonGridSizes =
+    GridSizes<GridSize<100, 100>, GridSize<110, 110>, GridSize<131, 131>,
+              GridSize<140, 140>, GridSize<141, 141>>;
+
+// Builds a char grid out of lines and calls fn(grid) with it, returning
+// whatever fn returns. If every line is W long and there are H of them for
+// one of the Sizes, the grid is a StaticGrid2D<char, W, H>; otherwise (test
+// inputs, ragged lines) it's a DenseGrid2D<char>. fn is instantiated for each
+// size, so it's usually a generic lambda taking auto &, and all of those have
+// to return the same type.
+template <typename Sizes = CommonGridSizes, typename Line, typename Fn>
+auto withLinesGrid(const std::vector<Line> &lines, Fn &&fn);
+
+#include "staticgrid.tpp"
+
+#endif
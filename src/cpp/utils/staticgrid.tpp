@@ -0,0 +1,304 @@
+#ifndef STATICGRID_TPP
+#define STATICGRID_TPP
+
+#include <densegrid.h>
+#include <grid.h>
+#include <range.h>
+
+#include <array>
+#include <iostream>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "staticgrid.h"
+
+template <typename T, int W, int H, typename Access>
+typename StaticGrid2D<T, W, H, Access>::iterator::reference
+StaticGrid2D<T, W, H, Access>::iterator::operator*() const {
+  Point2D point = StaticGrid2D<T, W, H, Access>::pointAt(this->pos);
+  return {point, (*this->grid)[point]};
+}
+
+template <typename T, int W, int H, typename Access>
+typename StaticGrid2D<T, W, H, Access>::iterator &
+StaticGrid2D<T, W, H, Access>::iterator::operator++() {
+  this->pos += this->step;
+  return *this;
+}
+
+template <typename T, int W, int H, typename Access>
+typename StaticGrid2D<T, W, H, Access>::iterator
+StaticGrid2D<T, W, H, Access>::iterator::operator++(int) {
+  iterator old = *this;
+  this->pos += this->step;
+  return old;
+}
+
+template <typename T, int W, int H, typename Access>
+bool StaticGrid2D<T, W, H, Access>::iterator::operator==(
+    const iterator &other) const {
+  return this->grid == other.grid && this->pos == other.pos;
+}
+
+template <typename T, int W, int H, typename Access>
+bool StaticGrid2D<T, W, H, Access>::iterator::operator!=(
+    const iterator &other) const {
+  return !(*this == other);
+}
+
+template <typename T, int W, int H, typename Access>
+StaticGrid2D<T, W, H, Access>::StaticGrid2D() {}
+
+template <typename T, int W, int H, typename Access>
+StaticGrid2D<T, W, H, Access>::StaticGrid2D(const T &fill) {
+  this->cells.fill(fill);
+}
+
+template <typename T, int W, int H, typename Access>
+size_t StaticGrid2D<T, W, H, Access>::index(const Point2D &point) {
+  return (size_t)point.y * W + point.x;
+}
+
+template <typename T, int W, int H, typename Access>
+Point2D StaticGrid2D<T, W, H, Access>::pointAt(long pos) {
+  return Point2D(pos % W, pos / W);
+}
+
+template <typename T, int W, int H, typename Access>
+T &StaticGrid2D<T, W, H, Access>::operator[](const Point2D &point) {
+  if constexpr (Access::CHECKED) {
+    if (!this->inBounds(point)) {
+      badGridAccess("StaticGrid2D::operator[]", point);
+    }
+  }
+  return this->cells[index(point)];
+}
+
+template <typename T, int W, int H, typename Access>
+const T &StaticGrid2D<T, W, H, Access>::operator[](
+    const Point2D &point) const {
+  if constexpr (Access::CHECKED) {
+    if (!this->inBounds(point)) {
+      badGridAccess("StaticGrid2D::operator[]", point);
+    }
+  }
+  return this->cells[index(point)];
+}
+
+template <typename T, int W, int H, typename Access>
+bool StaticGrid2D<T, W, H, Access>::operator==(
+    const StaticGrid2D<T, W, H, Access> &other) const {
+  return this->cells == other.cells;
+}
+
+template <typename T, int W, int H, typename Access>
+const T &StaticGrid2D<T, W, H, Access>::at(const Point2D &point) const {
+  if (!this->inBounds(point)) {
+    throwOutOfRange("StaticGrid2D::at", point);
+  }
+  return this->cells[index(point)];
+}
+
+template <typename T, int W, int H, typename Access>
+typename StaticGrid2D<T, W, H, Access>::iterator
+StaticGrid2D<T, W, H, Access>::find(const Point2D &point) const {
+  if (!this->inBounds(point)) {
+    return this->end();
+  }
+  return iterator(this, index(point), 1);
+}
+
+template <typename T, int W, int H, typename Access>
+typename StaticGrid2D<T, W, H, Access>::iterator
+StaticGrid2D<T, W, H, Access>::begin() const {
+  return iterator(this, 0, 1);
+}
+
+template <typename T, int W, int H, typename Access>
+typename StaticGrid2D<T, W, H, Access>::iterator
+StaticGrid2D<T, W, H, Access>::rbegin() const {
+  return iterator(this, (long)size() - 1, -1);
+}
+
+template <typename T, int W, int H, typename Access>
+typename StaticGrid2D<T, W, H, Access>::iterator
+StaticGrid2D<T, W, H, Access>::end() const {
+  return iterator(this, size(), 1);
+}
+
+template <typename T, int W, int H, typename Access>
+typename StaticGrid2D<T, W, H, Access>::iterator
+StaticGrid2D<T, W, H, Access>::rend() const {
+  return iterator(this, -1, -1);
+}
+
+template <typename T, int W, int H, typename Access>
+bool StaticGrid2D<T, W, H, Access>::inBounds(const Point2D &point) const {
+  // one unsigned compare per axis
+  return (unsigned)point.x < (unsigned)W && (unsigned)point.y < (unsigned)H;
+}
+
+template <typename T, int W, int H, typename Access>
+const T *StaticGrid2D<T, W, H, Access>::lookup(const Point2D &point) const {
+  if (!this->inBounds(point)) {
+    return nullptr;
+  }
+  return &this->cells[index(point)];
+}
+
+template <typename T, int W, int H, typename Access>
+NeighborRange<StaticGrid2D<T, W, H, Access>, T>
+StaticGrid2D<T, W, H, Access>::neighbors(const Point2D &point) const {
+  return this->neighbors(point, this->excludeDiagonals);
+}
+
+template <typename T, int W, int H, typename Access>
+NeighborRange<StaticGrid2D<T, W, H, Access>, T>
+StaticGrid2D<T, W, H, Access>::neighbors(const Point2D &point,
+                                         bool excludeDiagonals) const {
+  return NeighborRange<StaticGrid2D<T, W, H, Access>, T>(*this, point,
+                                                         excludeDiagonals);
+}
+
+template <typename T, int W, int H, typename Access>
+NeighborRange<StaticGrid2D<T, W, H, Access>, T, false>
+StaticGrid2D<T, W, H, Access>::interiorNeighbors(const Point2D &point) const {
+  return NeighborRange<StaticGrid2D<T, W, H, Access>, T, false>(
+      *this, point, this->excludeDiagonals);
+}
+
+template <typename T, int W, int H, typename Access>
+std::map<Point2D, T> StaticGrid2D<T, W, H, Access>::pointsAdjacent(
+    const Point2D &point) const {
+  std::map<Point2D, T> adjacent{};
+  for (const auto &pair : this->neighbors(point)) {
+    adjacent[pair.first] = pair.second;
+  }
+  return adjacent;
+}
+
+template <typename T, int W, int H, typename Access>
+DenseGrid2D<T, RowMajorLayout, Access>
+StaticGrid2D<T, W, H, Access>::subRegion(Range<int> xBounds,
+                                         Range<int> yBounds) const {
+  DenseGrid2D<T, RowMajorLayout, Access> newGrid(xBounds, yBounds);
+  newGrid.excludeDiagonals = this->excludeDiagonals;
+
+  for (int y = yBounds.min; y <= yBounds.max; y++) {
+    for (int x = xBounds.min; x <= xBounds.max; x++) {
+      newGrid[{x, y}] = this->at({x, y});
+    }
+  }
+
+  return newGrid;
+}
+
+template <typename T, int W, int H, typename Access>
+std::array<T, W> StaticGrid2D<T, W, H, Access>::row(int y) const {
+  std::array<T, W> row;
+  for (int x = 0; x < W; x++) {
+    row[x] = this->cells[index({x, y})];
+  }
+  return row;
+}
+
+template <typename T, int W, int H, typename Access>
+std::array<T, H> StaticGrid2D<T, W, H, Access>::col(int x) const {
+  std::array<T, H> col;
+  for (int y = 0; y < H; y++) {
+    col[y] = this->cells[index({x, y})];
+  }
+  return col;
+}
+
+template <typename T, int W, int H, typename Access>
+LineView<StaticGrid2D<T, W, H, Access>, T>
+StaticGrid2D<T, W, H, Access>::rowView(int y) const {
+  return this->regionView(xBounds, yBounds).row(y);
+}
+
+template <typename T, int W, int H, typename Access>
+LineView<StaticGrid2D<T, W, H, Access>, T>
+StaticGrid2D<T, W, H, Access>::colView(int x) const {
+  return this->regionView(xBounds, yBounds).col(x);
+}
+
+template <typename T, int W, int H, typename Access>
+RegionView<StaticGrid2D<T, W, H, Access>, T>
+StaticGrid2D<T, W, H, Access>::regionView(Range<int> xBounds,
+                                          Range<int> yBounds) const {
+  return RegionView<StaticGrid2D<T, W, H, Access>, T>(*this, xBounds,
+                                                      yBounds);
+}
+
+template <typename T, int W, int H, typename Access>
+RegionView<StaticGrid2D<T, W, H, Access>, T>
+StaticGrid2D<T, W, H, Access>::transposed() const {
+  return this->regionView(xBounds, yBounds).transposed();
+}
+
+template <typename T, int W, int H, typename Access>
+void StaticGrid2D<T, W, H, Access>::print() const {
+  for (int y = 0; y < H; y++) {
+    for (int x = 0; x < W; x++) {
+      std::cout << this->cells[index({x, y})];
+    }
+    std::cout << std::endl;
+  }
+}
+
+template <typename T, int W, int H, typename Access>
+void StaticGrid2D<T, W, H, Access>::swap(
+    StaticGrid2D<T, W, H, Access> &other) {
+  std::swap(this->excludeDiagonals, other.excludeDiagonals);
+  this->cells.swap(other.cells);
+}
+
+template <typename T, int W, int H, typename Access>
+void swap(StaticGrid2D<T, W, H, Access> &a, StaticGrid2D<T, W, H, Access> &b) {
+  a.swap(b);
+}
+
+// Tries each size in turn; the empty list is the DenseGrid2D fallback
+template <typename Sizes>
+struct LinesGridDispatch;
+
+template <>
+struct LinesGridDispatch<GridSizes<>> {
+  template <typename Line, typename Fn>
+  static auto run(const std::vector<Line> &lines, bool /*rectangular*/,
+                  Fn &&fn) {
+    auto grid = linesToGrid<DenseGrid2D<char>>(lines);
+    return fn(grid);
+  }
+};
+
+template <int W, int H, typename... Rest>
+struct LinesGridDispatch<GridSizes<GridSize<W, H>, Rest...>> {
+  template <typename Line, typename Fn>
+  static auto run(const std::vector<Line> &lines, bool rectangular, Fn &&fn) {
+    if (rectangular && lines.size() == (size_t)H &&
+        lines[0].length() == (size_t)W) {
+      StaticGrid2D<char, W, H> grid{};
+      for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+          grid[{x, y}] = lines[y][x];
+        }
+      }
+      return fn(grid);
+    }
+    return LinesGridDispatch<GridSizes<Rest...>>::run(lines, rectangular, fn);
+  }
+};
+
+template <typename Sizes, typename Line, typename Fn>
+auto withLinesGrid(const std::vector<Line> &lines, Fn &&fn) {
+  bool rectangular = !lines.empty();
+  for (const Line &line : lines) {
+    rectangular = rectangular && line.length() == lines[0].length();
+  }
+  return LinesGridDispatch<Sizes>::run(lines, rectangular, fn);
+}
+
+#endif
@@ -1,31 +1,94 @@
+#include <bytescan.h>
 #include <stringextras.h>
 
+#include <queue>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
-std::vector<std::string> strSplit(const std::string& str,
-                                  const std::string& delimiter) {
-  std::vector<std::string> tokens;
+StringTokenizer::StringTokenizer(std::string_view str,
+                                 std::string_view delimiter)
+    : str(str), delimiter(delimiter) {}
+
+StringTokenizer::StringTokenizer(std::string_view str, char delimiter)
+    : str(str), delimiterChar(delimiter) {}
 
-  size_t delimLength = delimiter.length();
+StringTokenizer::iterator StringTokenizer::begin() const {
+  iterator it{};
+  it.rest = this->str;
+  it.delimiter = this->delimiter;
+  it.delimiterChar = this->delimiterChar;
+  it.atEnd = false;
+  it.advance();
+  return it;
+}
+
+StringTokenizer::iterator StringTokenizer::end() const { return iterator{}; }
 
-  size_t lastPos = 0;
-  size_t pos = 0;
-  while (pos != std::string::npos) {
+void StringTokenizer::iterator::advance() {
+  while (!this->lastToken) {
     // find the next instance of the delimiter
-    pos = str.find(delimiter, lastPos);
-    // construct substr args from right after last delimiter to next delimeter
-    // (or end of string)
-    size_t len = pos == std::string::npos ? std::string::npos : pos - lastPos;
-    std::string sub = str.substr(lastPos, len);
-    if (sub.length() > 0) {
+    size_t pos = this->delimiter.empty()
+                     ? scanForByte(this->rest, this->delimiterChar)
+                     : scanFor(this->rest, this->delimiter);
+    if (pos == std::string_view::npos) {
+      this->token = this->rest;
+      this->rest = std::string_view{};
+      this->lastToken = true;
+    } else {
+      this->token = this->rest.substr(0, pos);
+      size_t delimLength = this->delimiter.empty() ? 1 : this->delimiter.size();
+      this->rest.remove_prefix(pos + delimLength);
+    }
+
+    if (!this->token.empty()) {
       // omit empty sections (multiple delimeters in a row count as one)
-      tokens.push_back(sub);
+      return;
     }
-    lastPos = pos + delimLength;
   }
 
+  this->token = std::string_view{};
+  this->atEnd = true;
+}
+
+StringTokenizer::iterator& StringTokenizer::iterator::operator++() {
+  this->advance();
+  return *this;
+}
+
+StringTokenizer::iterator StringTokenizer::iterator::operator++(int) {
+  iterator old = *this;
+  this->advance();
+  return old;
+}
+
+bool StringTokenizer::iterator::operator==(const iterator& other) const {
+  if (this->atEnd || other.atEnd) {
+    return this->atEnd == other.atEnd;
+  }
+  return this->token.data() == other.token.data();
+}
+
+bool StringTokenizer::iterator::operator!=(const iterator& other) const {
+  return !(*this == other);
+}
+
+StringTokenizer strTokens(std::string_view str, std::string_view delimiter) {
+  return StringTokenizer(str, delimiter);
+}
+
+StringTokenizer strTokens(std::string_view str, char delimiter) {
+  return StringTokenizer(str, delimiter);
+}
+
+std::vector<std::string> strSplit(const std::string& str,
+                                  const std::string& delimiter) {
+  std::vector<std::string> tokens;
+  for (std::string_view token : strTokens(str, delimiter)) {
+    tokens.emplace_back(token);
+  }
   return tokens;
 }
 
@@ -43,15 +106,143 @@ std::string strJoin(const std::vector<std::string>& vec,
   return oss.str();
 }
 
-// !! this can infinite loop if `find` contains `replace`! beware!
+MultiPatternMatcher::MultiPatternMatcher(
+    const std::vector<std::string>& patterns)
+    : patterns(patterns) {
+  Node root{};
+  root.next.fill(-1);
+  this->nodes.push_back(root);
+
+  // trie of all patterns
+  for (size_t p = 0; p < patterns.size(); p++) {
+    if (patterns[p].empty()) {
+      // it would match at every position, including the end of the text
+      throw std::invalid_argument("MultiPatternMatcher: empty pattern");
+    }
+    int state = 0;
+    for (char ch : patterns[p]) {
+      unsigned char byte = ch;
+      if (this->nodes[state].next[byte] == -1) {
+        Node node{};
+        node.next.fill(-1);
+        this->nodes[state].next[byte] = this->nodes.size();
+        this->nodes.push_back(node);
+      }
+      state = this->nodes[state].next[byte];
+    }
+    if (this->nodes[state].output == -1) {
+      // duplicate patterns report the first one
+      this->nodes[state].output = p;
+    }
+  }
+
+  // BFS to fill in failure links and turn missing edges into the transitions
+  // the failure links would have taken
+  std::queue<int> q;
+  for (int& child : this->nodes[0].next) {
+    if (child == -1) {
+      child = 0;
+    } else {
+      this->nodes[child].fail = 0;
+      q.push(child);
+    }
+  }
+
+  while (!q.empty()) {
+    int state = q.front();
+    q.pop();
+
+    int fail = this->nodes[state].fail;
+    this->nodes[state].outputLink = this->nodes[fail].output != -1
+                                        ? fail
+                                        : this->nodes[fail].outputLink;
+
+    for (int byte = 0; byte < 256; byte++) {
+      int child = this->nodes[state].next[byte];
+      if (child == -1) {
+        this->nodes[state].next[byte] = this->nodes[fail].next[byte];
+      } else {
+        this->nodes[child].fail = this->nodes[fail].next[byte];
+        q.push(child);
+      }
+    }
+  }
+}
+
+std::vector<MultiPatternMatcher::Match> MultiPatternMatcher::findAll(
+    std::string_view text) const {
+  std::vector<Match> matches{};
+  this->forEachMatch(text, [&matches](Match m) { matches.push_back(m); });
+  return matches;
+}
+
+std::vector<MultiPatternMatcher::Match> MultiPatternMatcher::findNonOverlapping(
+    std::string_view text) const {
+  // longest pattern starting at each position
+  std::vector<int> longestAt(text.size(), -1);
+  this->forEachMatch(text, [&](Match m) {
+    int& best = longestAt[m.position];
+    if (best == -1 ||
+        this->patterns[m.pattern].size() > this->patterns[best].size()) {
+      best = m.pattern;
+    }
+  });
+
+  std::vector<Match> matches{};
+  size_t i = 0;
+  while (i < text.size()) {
+    if (longestAt[i] != -1) {
+      matches.push_back(Match{i, static_cast<size_t>(longestAt[i])});
+      i += this->patterns[longestAt[i]].size();
+    } else {
+      i++;
+    }
+  }
+  return matches;
+}
+
+std::string MultiPatternMatcher::replaceAll(
+    std::string_view text, const std::vector<std::string>& replacements) const {
+  std::string rval{};
+  rval.reserve(text.size());
+
+  size_t copied = 0;
+  for (const auto& match : this->findNonOverlapping(text)) {
+    rval.append(text.substr(copied, match.position - copied));
+    rval.append(replacements[match.pattern]);
+    copied = match.position + this->patterns[match.pattern].size();
+  }
+  rval.append(text.substr(copied));
+
+  return rval;
+}
+
+const std::string& MultiPatternMatcher::pattern(size_t idx) const {
+  return this->patterns[idx];
+}
+
+size_t MultiPatternMatcher::size() const { return this->patterns.size(); }
+
+// Single left-to-right pass; text produced by a replacement is not searched
+// again, so `replace` containing `find` is fine. For several patterns at once,
+// use MultiPatternMatcher::replaceAll.
 std::string strReplace(const std::string& original, const std::string& find,
                        const std::string& replace) {
-  std::string rval = original;
+  if (find.empty()) {
+    return original;
+  }
+
+  std::string rval{};
+  rval.reserve(original.size());
 
+  size_t copied = 0;
   size_t found;
-  while ((found = rval.find(find)) != std::string::npos) {
-    rval.replace(found, find.length(), replace);
+  while ((found = scanFor(original, find, copied)) != std::string::npos) {
+    rval.append(original, copied, found - copied);
+    rval.append(replace);
+    copied = found + find.length();
   }
+  rval.append(original, copied);
 
   return rval;
 }
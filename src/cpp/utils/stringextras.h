@@ -1,9 +1,111 @@
 #ifndef STRING_EXTRAS_H
 #define STRING_EXTRAS_H
 
+#include <array>
+#include <cstddef>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <vector>
 
+// Lazy, non-allocating split. Iterating yields string_views into the original
+// buffer, so it must outlive the tokens. Like strSplit, runs of delimiters
+// count as one (empty tokens are skipped). Delimiters must be non-empty.
+class StringTokenizer {
+ public:
+  class iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::string_view*;
+    using reference = const std::string_view&;
+
+    iterator() = default;
+
+    reference operator*() const { return this->token; }
+    pointer operator->() const { return &this->token; }
+    iterator& operator++();
+    iterator operator++(int);
+    bool operator==(const iterator& other) const;
+    bool operator!=(const iterator& other) const;
+
+   private:
+    friend class StringTokenizer;
+
+    std::string_view rest{};
+    std::string_view token{};
+    std::string_view delimiter{};
+    char delimiterChar = '\0';
+    bool lastToken = false;
+    bool atEnd = true;
+
+    void advance();
+  };
+
+  StringTokenizer(std::string_view str, std::string_view delimiter);
+  StringTokenizer(std::string_view str, char delimiter);
+
+  iterator begin() const;
+  iterator end() const;
+
+ private:
+  std::string_view str;
+  // empty when splitting on delimiterChar
+  std::string_view delimiter;
+  char delimiterChar = '\0';
+};
+
+// Aho-Corasick automaton over a fixed dictionary. Built once, then every scan
+// is a single linear pass over the text no matter how many patterns there are.
+class MultiPatternMatcher {
+ public:
+  struct Match {
+    size_t position;
+    // index into the patterns the matcher was built from
+    size_t pattern;
+  };
+
+  // throws std::invalid_argument if any pattern is empty
+  MultiPatternMatcher(const std::vector<std::string>& patterns);
+
+  // Calls fn(Match) for every occurrence of every pattern, overlapping ones
+  // included (both "one" and "eight" in "oneight"). Matches are reported in
+  // order of where they end.
+  template <typename Fn>
+  void forEachMatch(std::string_view text, Fn fn) const;
+
+  std::vector<Match> findAll(std::string_view text) const;
+
+  // Leftmost-longest occurrences that don't overlap, ordered by position
+  std::vector<Match> findNonOverlapping(std::string_view text) const;
+
+  // Replaces each non-overlapping occurrence of patterns[i] with
+  // replacements[i] in one pass. Replaced text is never rescanned.
+  std::string replaceAll(std::string_view text,
+                         const std::vector<std::string>& replacements) const;
+
+  const std::string& pattern(size_t idx) const;
+  size_t size() const;
+
+ private:
+  struct Node {
+    // full transition table, so scanning never walks failure links
+    std::array<int, 256> next;
+    int fail = 0;
+    // pattern that ends exactly here, or -1
+    int output = -1;
+    // nearest node down the failure chain that has an output, or -1
+    int outputLink = -1;
+  };
+
+  std::vector<std::string> patterns;
+  std::vector<Node> nodes;
+};
+
+StringTokenizer strTokens(std::string_view str, std::string_view delimiter);
+StringTokenizer strTokens(std::string_view str, char delimiter);
+
 std::vector<std::string> strSplit(const std::string& str,
                                   const std::string& delimiter);
 
@@ -13,4 +115,6 @@ std::string strJoin(const std::vector<std::string>& vec,
 std::string strReplace(const std::string& original, const std::string& find,
                        const std::string& replace);
 
+#include "stringextras.tpp"
+
 #endif
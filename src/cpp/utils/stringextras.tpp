@@ -0,0 +1,26 @@
+#ifndef STRING_EXTRAS_TPP
+#define STRING_EXTRAS_TPP
+
+#include <string_view>
+
+#include "stringextras.h"
+
+template <typename Fn>
+void MultiPatternMatcher::forEachMatch(std::string_view text, Fn fn) const {
+  int state = 0;
+  for (size_t i = 0; i < text.size(); i++) {
+    state = this->nodes[state].next[static_cast<unsigned char>(text[i])];
+
+    // every pattern ending at i is on this node's output chain
+    int found = this->nodes[state].output != -1
+                    ? state
+                    : this->nodes[state].outputLink;
+    while (found != -1) {
+      size_t pattern = this->nodes[found].output;
+      fn(Match{i + 1 - this->patterns[pattern].size(), pattern});
+      found = this->nodes[found].outputLink;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,38 @@
+#include <unionfind.h>
+
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+DisjointSets::DisjointSets() {}
+
+DisjointSets::DisjointSets(size_t size) { this->reset(size); }
+
+void DisjointSets::reset(size_t size) {
+  this->parents.resize(size);
+  std::iota(this->parents.begin(), this->parents.end(), 0);
+}
+
+size_t DisjointSets::find(size_t element) {
+  while (this->parents[element] != element) {
+    this->parents[element] = this->parents[this->parents[element]];
+    element = this->parents[element];
+  }
+  return element;
+}
+
+bool DisjointSets::unite(size_t a, size_t b) {
+  a = this->find(a);
+  b = this->find(b);
+  if (a == b) {
+    return false;
+  }
+  if (b < a) {
+    std::swap(a, b);
+  }
+  this->parents[b] = a;
+  return true;
+}
+
+size_t DisjointSets::size() const { return this->parents.size(); }
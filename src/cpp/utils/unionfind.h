@@ -0,0 +1,28 @@
+#ifndef UNIONFIND_H
+#define UNIONFIND_H
+
+#include <cstddef>
+#include <vector>
+
+// Union-find over the integers [0, size) in one flat array. find() halves
+// paths as it walks them, and unite() always keeps the smaller root, so every
+// set's root is its smallest member.
+class DisjointSets {
+ public:
+  DisjointSets();
+  DisjointSets(size_t size);
+
+  // back to size singleton sets
+  void reset(size_t size);
+  // only touches the element's own set, so threads working on disjoint sets
+  // can share one DisjointSets
+  size_t find(size_t element);
+  // merges the two sets; returns false if they were already one
+  bool unite(size_t a, size_t b);
+  size_t size() const;
+
+ private:
+  std::vector<size_t> parents{};
+};
+
+#endif
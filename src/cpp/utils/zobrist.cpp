@@ -0,0 +1,51 @@
+#include <zobrist.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+// splitmix64's finalizer: every input bit affects every output bit
+uint64_t mix(uint64_t value) {
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+  return value ^ (value >> 31);
+}
+
+const uint64_t LOW_SEED = 0x9e3779b97f4a7c15;
+const uint64_t HIGH_SEED = 0xd1b54a32d192ed03;
+
+// seeds give independent keys for the two halves of a 128-bit hash
+uint64_t cellKey(uint64_t cell, uint64_t valueHash, uint64_t seed) {
+  return mix(mix(cell + seed) ^ mix(valueHash ^ seed));
+}
+
+}  // namespace
+
+bool GridHash::operator==(const GridHash &other) const {
+  return this->low == other.low && this->high == other.high;
+}
+
+bool GridHash::operator!=(const GridHash &other) const {
+  return !(*this == other);
+}
+
+bool GridHash::operator<(const GridHash &other) const {
+  if (this->high == other.high) {
+    return this->low < other.low;
+  } else {
+    return this->high < other.high;
+  }
+}
+
+ZobristHash::ZobristHash(bool wide) : wide(wide) {}
+
+GridHash ZobristHash::value() const { return this->hash; }
+
+void ZobristHash::toggleKey(int x, int y, size_t valueHash) {
+  uint64_t cell = ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
+  this->hash.low ^= cellKey(cell, valueHash, LOW_SEED);
+  if (this->wide) {
+    this->hash.high ^= cellKey(cell, valueHash, HIGH_SEED);
+  }
+}
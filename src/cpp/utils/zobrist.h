@@ -0,0 +1,48 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// Fingerprint of a grid's contents. high is only filled in for 128-bit hashes
+struct GridHash {
+  uint64_t low = 0;
+  uint64_t high = 0;
+
+  bool operator==(const GridHash &other) const;
+  bool operator!=(const GridHash &other) const;
+  bool operator<(const GridHash &other) const;
+};
+
+// Running Zobrist hash of a set of (x, y, value) cells: the XOR of a
+// pseudo-random key per cell, so toggling one cell in or out is O(1) and the
+// same contents always hash the same no matter how they were written. Keys are
+// derived by mixing the coordinates with std::hash of the value instead of
+// coming out of a table, so any hashable T works.
+class ZobristHash {
+ public:
+  ZobristHash(bool wide = false);
+
+  // XORs the cell's key in if it isn't part of the hash yet, or out if it is
+  template <typename T>
+  void toggle(int x, int y, const T &value);
+  GridHash value() const;
+
+ private:
+  bool wide;
+  GridHash hash{};
+
+  void toggleKey(int x, int y, size_t valueHash);
+};
+
+namespace std {
+template <>
+struct hash<GridHash> {
+  size_t operator()(const GridHash &hash) const { return hash.low; }
+};
+}  // namespace std
+
+#include "zobrist.tpp"
+
+#endif
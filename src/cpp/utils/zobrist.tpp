@@ -0,0 +1,13 @@
+#ifndef ZOBRIST_TPP
+#define ZOBRIST_TPP
+
+#include <functional>
+
+#include "zobrist.h"
+
+template <typename T>
+void ZobristHash::toggle(int x, int y, const T &value) {
+  this->toggleKey(x, y, std::hash<T>{}(value));
+}
+
+#endif